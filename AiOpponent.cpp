@@ -0,0 +1,197 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <vector>
+#include "Constants.hpp"
+#include "TableState.cpp"
+#include "EventEngine.cpp"
+#include "Shot.cpp"
+#include "Rules.cpp"
+#include "MatchRules.cpp"
+#include "WorkStealingPool.cpp"
+
+// Lawan komputer berbasis Monte Carlo. Setiap kandidat (sudut, kekuatan) memakai
+// model gaya Stick::endMove, disimulasikan tanpa window sampai semua bola diam
+// dengan EventEngine, lalu dinilai dengan aturan pocket MatchRules dan findFoul.
+// Rollout dibagi ke semua core lewat WorkStealingPool sampai batas waktu habis.
+class AiOpponent {
+private:
+    // State dan engine milik satu worker, dipakai ulang di setiap rollout
+    struct Rollout {
+        TableState state;
+        EventEngine engine;
+
+        Rollout(const TableGeometry& geometry, float ballRadius) : engine(state, geometry, ballRadius) {}
+    };
+
+    struct Candidate {
+        Shot shot;
+        float score;
+    };
+
+    const TableGeometry& geometry;
+    float ballRadius;
+    WorkStealingPool pool;
+    std::vector<std::unique_ptr<Rollout>> rollouts;
+    std::chrono::milliseconds timeBudget;
+    int lastRolloutCount;
+
+    static const int TasksPerWorker = 4;
+    static const int RolloutsPerTask = 16;
+
+    // Apakah pemukul menang bila bola 8 masuk, menurut MatchRules::pocket pada giliran ini.
+    static bool eightBallWins(const MatchRules& rules) {
+        MatchRules outcome = rules;
+        outcome.pocket(8);
+        return outcome.getWinner() == rules.getCurrentPlayer();
+    }
+
+    // Nilai hasil pukulan dari sudut pandang pemain dengan grup playerType.
+    float scoreOutcome(const TableState& before, const TableState& after, int playerType, bool eightWins) const {
+        if (findFoul(after, playerType) != NoFoul) {
+            return -100.0f;
+        }
+
+        float score = 0.0f;
+        for (std::size_t i = 1; i < after.size(); ++i) {
+            int id = static_cast<int>(i);
+            if (before.isPocketed(id) || !after.isPocketed(id)) continue;
+
+            if (id == 8) {
+                return eightWins ? 1000.0f : -1000.0f;
+            }
+            if (playerType == -1 || ballGroup(id) == playerType) {
+                score += 10.0f;
+            } else {
+                score -= 5.0f;
+            }
+        }
+
+        // Tie-breaker kecil: bola sendiri yang tersisa sebaiknya dekat lubang
+        for (std::size_t i = 1; i < after.size(); ++i) {
+            int id = static_cast<int>(i);
+            if (after.isPocketed(id) || (playerType != -1 && ballGroup(id) != playerType)) continue;
+
+            float nearest = 1e9f;
+            for (const auto& pocket : geometry.getPockets()) {
+                float dx = after.posX[i] - pocket.cx;
+                float dy = after.posY[i] - pocket.cy;
+                nearest = std::min(nearest, dx * dx + dy * dy);
+            }
+            score -= std::sqrt(nearest) * 0.001f;
+        }
+        return score;
+    }
+
+    // Separuh kandidat diarahkan ke "ghost ball" bola target menuju lubang, sisanya acak.
+    Shot sampleShot(const TableState& table, int playerType, bool eightWins, std::mt19937& rng) const {
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        std::uniform_real_distribution<float> power(MaxCueForce * 0.1f, MaxCueForce);
+        Shot shot;
+        shot.power = power(rng);
+
+        if (unit(rng) < 0.5f) {
+            std::vector<int> targets;
+            for (std::size_t i = 1; i < table.size(); ++i) {
+                int id = static_cast<int>(i);
+                if (table.isPocketed(id)) continue;
+                if (id == 8 ? eightWins : (playerType == -1 || ballGroup(id) == playerType)) {
+                    targets.push_back(id);
+                }
+            }
+            if (!targets.empty()) {
+                int target = targets[std::uniform_int_distribution<int>(0, static_cast<int>(targets.size()) - 1)(rng)];
+                const auto& pockets = geometry.getPockets();
+                const auto& pocket = pockets[std::uniform_int_distribution<std::size_t>(0, pockets.size() - 1)(rng)];
+                float px = pocket.cx;
+                float py = pocket.cy;
+
+                float dx = px - table.posX[target];
+                float dy = py - table.posY[target];
+                float length = std::sqrt(dx * dx + dy * dy);
+                float ghostX = table.posX[target] - dx / length * 2 * ballRadius;
+                float ghostY = table.posY[target] - dy / length * 2 * ballRadius;
+
+                std::normal_distribution<float> jitter(0.0f, 0.01f);
+                shot.angle = std::atan2(ghostY - table.posY[CueBallIndex], ghostX - table.posX[CueBallIndex]) + jitter(rng);
+                return shot;
+            }
+        }
+
+        shot.angle = unit(rng) * 2.0f * 3.14159265f;
+        return shot;
+    }
+
+public:
+    explicit AiOpponent(std::chrono::milliseconds budget = std::chrono::milliseconds(200))
+        : AiOpponent(defaultTableGeometry(), BallRadius, budget) {}
+
+    // tableGeometry harus hidup lebih lama dari lawan komputer ini.
+    AiOpponent(const TableGeometry& tableGeometry, float radius,
+               std::chrono::milliseconds budget = std::chrono::milliseconds(200))
+        : geometry(tableGeometry), ballRadius(radius), timeBudget(budget), lastRolloutCount(0) {
+        for (std::size_t i = 0; i < pool.size(); ++i) {
+            rollouts.push_back(std::unique_ptr<Rollout>(new Rollout(geometry, ballRadius)));
+        }
+    }
+
+    // Cari pukulan terbaik untuk posisi meja saat ini dalam batas waktu, bagi pemain
+    // yang sedang giliran di rules.
+    Shot chooseShot(const TableState& table, const MatchRules& rules, unsigned seed = std::random_device()()) {
+        const int playerType = rules.getPlayerType(rules.getCurrentPlayer());
+        const bool eightWins = eightBallWins(rules);
+        const auto deadline = std::chrono::steady_clock::now() + timeBudget;
+        std::mutex bestMutex;
+        Candidate best = { { 0.0f, MaxCueForce * 0.5f }, -1e9f };
+        std::atomic<int> rolloutCount(0);
+        unsigned batch = 0;
+
+        while (std::chrono::steady_clock::now() < deadline) {
+            const unsigned tasks = static_cast<unsigned>(pool.size()) * TasksPerWorker;
+            for (unsigned t = 0; t < tasks; ++t) {
+                const unsigned taskSeed = seed + batch * tasks + t;
+                pool.submit([&, taskSeed] {
+                    Rollout& rollout = *rollouts[pool.currentWorker()];
+                    std::mt19937 rng(taskSeed);
+                    Candidate local = { { 0.0f, 0.0f }, -1e9f };
+
+                    for (int r = 0; r < RolloutsPerTask; ++r) {
+                        if (std::chrono::steady_clock::now() >= deadline) break;
+
+                        Shot shot = sampleShot(table, playerType, eightWins, rng);
+                        rollout.state = table;
+                        applyShot(rollout.state, shot);
+                        rollout.engine.reset();
+                        rollout.engine.runToRest();
+                        rolloutCount.fetch_add(1, std::memory_order_relaxed);
+
+                        float score = scoreOutcome(table, rollout.state, playerType, eightWins);
+                        if (score > local.score) {
+                            local.shot = shot;
+                            local.score = score;
+                        }
+                    }
+
+                    std::lock_guard<std::mutex> lock(bestMutex);
+                    if (local.score > best.score) {
+                        best = local;
+                    }
+                });
+            }
+            pool.wait();
+            ++batch;
+        }
+
+        lastRolloutCount = rolloutCount.load();
+        return best.shot;
+    }
+
+    int getLastRolloutCount() const {
+        return lastRolloutCount;
+    }
+};
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cmath>
+#include "Constants.hpp"
+#include "TableState.cpp"
+#include "EventEngine.cpp"
+#include "Shot.cpp"
+
+// Garis bidik berdasarkan simulasi: jalur bola putih sampai kontak pertama
+// (termasuk pantulan cushion pertama), posisi ghost ball, dan arah bola target.
+// Prediksi dijalankan di TableState salinan dengan EventEngine, dan hanya
+// dihitung ulang bila sudut atau kekuatan berubah melewati ambang.
+class AimPredictor : public sf::Drawable {
+private:
+    TableState scratch;
+    EventEngine engine;
+    sf::VertexArray lines;
+    float ballRadius;
+
+    Shot lastShot;
+    float lastCueX, lastCueY;
+    bool valid;
+
+    static constexpr float AngleThreshold = 0.002f; // radian
+    static constexpr float PowerThreshold = 5.0f;
+    static constexpr float DashLength = 5.0f;
+    static constexpr float GapLength = 5.0f;
+    static constexpr int MaxEvents = 64;
+    static constexpr int GhostSegments = 24;
+
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override {
+        target.draw(lines, states);
+    }
+
+    void addLine(double x0, double y0, double x1, double y1, const sf::Color& color) {
+        lines.append(sf::Vertex(sf::Vector2f(static_cast<float>(x0) + OFFSET_X, static_cast<float>(y0) + OFFSET_Y), color));
+        lines.append(sf::Vertex(sf::Vector2f(static_cast<float>(x1) + OFFSET_X, static_cast<float>(y1) + OFFSET_Y), color));
+    }
+
+    void addDashedLine(double x0, double y0, double x1, double y1, const sf::Color& color) {
+        double dx = x1 - x0;
+        double dy = y1 - y0;
+        double length = std::sqrt(dx * dx + dy * dy);
+        if (length <= 0.0) return;
+        dx /= length;
+        dy /= length;
+
+        for (double d = 0.0; d < length; d += DashLength + GapLength) {
+            double end = std::min(d + DashLength, length);
+            addLine(x0 + dx * d, y0 + dy * d, x0 + dx * end, y0 + dy * end, color);
+        }
+    }
+
+    void addCircle(double cx, double cy, double radius, const sf::Color& color) {
+        const double step = 2.0 * 3.14159265358979 / GhostSegments;
+        for (int k = 0; k < GhostSegments; ++k) {
+            addLine(cx + radius * std::cos(k * step), cy + radius * std::sin(k * step),
+                    cx + radius * std::cos((k + 1) * step), cy + radius * std::sin((k + 1) * step), color);
+        }
+    }
+
+    bool needsUpdate(const TableState& state, const Shot& shot) const {
+        if (!valid) return true;
+        if (state.posX[CueBallIndex] != lastCueX || state.posY[CueBallIndex] != lastCueY) return true;
+
+        float angleDelta = std::remainder(shot.angle - lastShot.angle, 2.0f * 3.14159265f);
+        return std::fabs(angleDelta) > AngleThreshold || std::fabs(shot.power - lastShot.power) > PowerThreshold;
+    }
+
+    void predict(const TableState& state, const Shot& shot) {
+        lines.clear();
+        scratch = state;
+        applyShot(scratch, shot);
+        engine.reset();
+
+        const sf::Color pathColor = sf::Color::White;
+        const sf::Color objectColor(255, 255, 0);
+        const sf::Color bounceColor(180, 180, 180);
+
+        double fromX = scratch.posX[CueBallIndex];
+        double fromY = scratch.posY[CueBallIndex];
+        bool bounced = false;
+
+        EventEngine::EventRecord record;
+        for (int n = 0; n < MaxEvents && engine.processNext(record); ++n) {
+            const bool involvesCue = record.a == CueBallIndex || (record.type == EventEngine::BallBall && record.b == CueBallIndex);
+            if (!involvesCue) continue;
+
+            double x, y;
+            engine.positionOf(CueBallIndex, x, y);
+            addDashedLine(fromX, fromY, x, y, bounced ? bounceColor : pathColor);
+            fromX = x;
+            fromY = y;
+
+            if (record.type == EventEngine::Cushion) {
+                if (bounced) return; // cukup sampai pantulan pertama
+                bounced = true;
+                continue;
+            }
+
+            if (record.type == EventEngine::BallBall) {
+                int target = (record.a == CueBallIndex) ? record.b : record.a;
+                addCircle(x, y, ballRadius, pathColor);
+
+                double tx, ty, tvx, tvy;
+                engine.positionOf(target, tx, ty);
+                engine.velocityOf(target, tvx, tvy);
+                double speed = std::sqrt(tvx * tvx + tvy * tvy);
+                if (speed > 0.0) {
+                    double length = std::min(speed * 0.15, 250.0);
+                    addLine(tx, ty, tx + tvx / speed * length, ty + tvy / speed * length, objectColor);
+                }
+
+                double cvx, cvy;
+                engine.velocityOf(CueBallIndex, cvx, cvy);
+                double cueSpeed = std::sqrt(cvx * cvx + cvy * cvy);
+                if (cueSpeed > 0.0) {
+                    double length = std::min(cueSpeed * 0.15, 120.0);
+                    addDashedLine(x, y, x + cvx / cueSpeed * length, y + cvy / cueSpeed * length, bounceColor);
+                }
+            }
+            return; // kontak bola, lubang, atau berhenti
+        }
+    }
+
+public:
+    // geometry harus hidup lebih lama dari prediktor ini.
+    explicit AimPredictor(const TableGeometry& geometry = defaultTableGeometry(), float radius = BallRadius)
+        : engine(scratch, geometry, radius), lines(sf::Lines), ballRadius(radius), lastShot{ 0.0f, 0.0f },
+          lastCueX(0.0f), lastCueY(0.0f), valid(false) {}
+
+    // Perbarui prediksi untuk pukulan yang sedang dibidik.
+    void update(const TableState& state, const Shot& shot) {
+        if (!needsUpdate(state, shot)) return;
+
+        predict(state, shot);
+        lastShot = shot;
+        lastCueX = state.posX[CueBallIndex];
+        lastCueY = state.posY[CueBallIndex];
+        valid = true;
+    }
+
+    void clear() {
+        lines.clear();
+        valid = false;
+    }
+};
@@ -0,0 +1,187 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// Root aset bawaan: variabel lingkungan BILLIARD_ASSET_ROOT, atau folder kerja
+// (berisi bg/ dan font/).
+inline std::string defaultAssetRoot() {
+    const char* root = std::getenv("BILLIARD_ASSET_ROOT");
+    return (root && *root) ? root : ".";
+}
+
+// Cache tekstur dan font bersama, dikunci dengan path relatif terhadap root.
+// preload*() mendekode file di thread latar (misalnya selama StartMenu tampil);
+// texture()/font() menunggu hasilnya bila belum selesai. Pemakai menyimpan
+// shared_ptr, dan releaseUnused() membuang aset yang tidak dipakai lagi.
+// Gambar didekode di thread latar, tetapi upload ke GPU dilakukan di thread
+// pemanggil texture() karena tekstur butuh konteks OpenGL.
+class AssetCache {
+private:
+    struct TextureEntry {
+        std::shared_future<std::shared_ptr<sf::Image>> image;
+        std::shared_ptr<sf::Texture> texture;
+        bool uploaded = false;
+    };
+
+    std::string root;
+    std::map<std::string, TextureEntry> textures;
+    std::map<std::string, std::shared_future<std::shared_ptr<sf::Font>>> fonts;
+    std::mutex mutex;
+
+    std::thread worker;
+    std::deque<std::function<void()>> jobs;
+    std::condition_variable jobReady;
+    bool stopping;
+
+    void run() {
+        while (true) {
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                jobReady.wait(lock, [this] { return stopping || !jobs.empty(); });
+                if (jobs.empty()) return;
+                job = std::move(jobs.front());
+                jobs.pop_front();
+            }
+            job();
+        }
+    }
+
+    // Dipanggil dengan mutex terkunci.
+    template <typename T>
+    std::shared_future<std::shared_ptr<T>> enqueue(std::function<std::shared_ptr<T>()> load) {
+        if (!worker.joinable()) {
+            worker = std::thread(&AssetCache::run, this);
+        }
+        auto task = std::make_shared<std::packaged_task<std::shared_ptr<T>()>>(std::move(load));
+        std::shared_future<std::shared_ptr<T>> result = task->get_future().share();
+        jobs.push_back([task] { (*task)(); });
+        jobReady.notify_one();
+        return result;
+    }
+
+    // Dipanggil dengan mutex terkunci.
+    TextureEntry& textureEntry(const std::string& path) {
+        auto found = textures.find(path);
+        if (found != textures.end()) return found->second;
+
+        std::string file = resolve(path);
+        TextureEntry& entry = textures[path];
+        entry.image = enqueue<sf::Image>([file] {
+            auto image = std::make_shared<sf::Image>();
+            if (!image->loadFromFile(file)) {
+                std::cerr << "Gagal memuat gambar " << file << std::endl;
+                return std::shared_ptr<sf::Image>();
+            }
+            return image;
+        });
+        return entry;
+    }
+
+    // Dipanggil dengan mutex terkunci.
+    std::shared_future<std::shared_ptr<sf::Font>>& fontEntry(const std::string& path) {
+        auto found = fonts.find(path);
+        if (found != fonts.end()) return found->second;
+
+        std::string file = resolve(path);
+        return fonts[path] = enqueue<sf::Font>([file] {
+            auto font = std::make_shared<sf::Font>();
+            if (!font->loadFromFile(file)) {
+                std::cerr << "Gagal memuat font " << file << std::endl;
+                return std::shared_ptr<sf::Font>();
+            }
+            return font;
+        });
+    }
+
+public:
+    explicit AssetCache(const std::string& assetRoot = defaultAssetRoot()) : root(assetRoot), stopping(false) {}
+
+    ~AssetCache() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        jobReady.notify_all();
+        if (worker.joinable()) worker.join();
+    }
+
+    AssetCache(const AssetCache&) = delete;
+    AssetCache& operator=(const AssetCache&) = delete;
+
+    std::string resolve(const std::string& path) const {
+        return root.empty() ? path : root + "/" + path;
+    }
+
+    void preloadTexture(const std::string& path) {
+        std::lock_guard<std::mutex> lock(mutex);
+        textureEntry(path);
+    }
+
+    void preloadFont(const std::string& path) {
+        std::lock_guard<std::mutex> lock(mutex);
+        fontEntry(path);
+    }
+
+    // Tekstur untuk path; nullptr bila file gagal dimuat.
+    std::shared_ptr<sf::Texture> texture(const std::string& path) {
+        std::shared_future<std::shared_ptr<sf::Image>> image;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            TextureEntry& entry = textureEntry(path);
+            if (entry.uploaded) return entry.texture;
+            image = entry.image;
+        }
+
+        std::shared_ptr<sf::Image> decoded = image.get();
+        std::shared_ptr<sf::Texture> texture;
+        if (decoded) {
+            texture = std::make_shared<sf::Texture>();
+            if (!texture->loadFromImage(*decoded)) texture.reset();
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        TextureEntry& entry = textures[path];
+        if (!entry.uploaded) {
+            entry.texture = texture;
+            entry.uploaded = true;
+            entry.image = std::shared_future<std::shared_ptr<sf::Image>>(); // piksel di CPU tidak dibutuhkan lagi
+        }
+        return entry.texture;
+    }
+
+    // Font untuk path; nullptr bila file gagal dimuat.
+    std::shared_ptr<sf::Font> font(const std::string& path) {
+        std::shared_future<std::shared_ptr<sf::Font>> result;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            result = fontEntry(path);
+        }
+        return result.get();
+    }
+
+    // Buang aset yang sudah selesai dimuat dan hanya dipegang oleh cache.
+    void releaseUnused() {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto it = textures.begin(); it != textures.end();) {
+            if (it->second.uploaded && it->second.texture.use_count() <= 1) it = textures.erase(it);
+            else ++it;
+        }
+        for (auto it = fonts.begin(); it != fonts.end();) {
+            bool ready = it->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+            if (ready && it->second.get().use_count() <= 1) it = fonts.erase(it);
+            else ++it;
+        }
+    }
+};
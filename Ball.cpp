@@ -3,23 +3,26 @@
 #include <SFML/Graphics.hpp>
 #include <cmath>
 #include "Constants.hpp"
+#include "TableState.cpp"
+#include "Shot.cpp"
 
+// Tampilan satu bola di atas TableState; state fisika tidak disimpan di sini.
 class Ball {
 private:
+    TableState* state;
+    int index;
     int id; 
     bool isStriped;
-    bool hit; 
-    bool pocketed;
     sf::Color color; 
     sf::CircleShape shape; 
-    sf::Vector2f velocity;
+    sf::CircleShape stripe;
     sf::Vector2f initialPosition;
     sf::Text text;
 
 public:
     // Constructor
-    Ball(float radius, sf::Vector2f position, sf::Color color, int id, const sf::Font& font)
-        : velocity(0.0f, 0.0f), initialPosition(position), isStriped(false), id(id), color(color), pocketed(false) { 
+    Ball(TableState& table, float radius, sf::Vector2f position, sf::Color color, int id, const sf::Font& font)
+        : state(&table), index(table.addBall(position.x, position.y)), id(id), isStriped(false), color(color), initialPosition(position) { 
 
         if (id >= 9 && id <= 15) {
             isStriped = true;
@@ -28,50 +31,53 @@ public:
         shape.setRadius(radius);  
         shape.setFillColor(color); 
         shape.setOrigin(radius, radius);
-        shape.setPosition(position + sf::Vector2f(OFFSET_X, OFFSET_Y));
         shape.setOutlineThickness(2);
         shape.setOutlineColor(sf::Color::Black);
 
+        stripe.setRadius(radius / 1.5f);
+        stripe.setFillColor(sf::Color::White);
+        stripe.setOrigin(stripe.getRadius(), stripe.getRadius());
+
         text.setFont(font);
         text.setString(std::to_string(id));
-        text.setCharacterSize(radius);
-        text.setFillColor(sf::Color::Black);
+        text.setCharacterSize(static_cast<unsigned>(radius)); // 18 pada meja bawaan
+        text.setFillColor((id == 8) ? sf::Color::White : sf::Color::Black);
         text.setStyle(sf::Text::Bold);
-
-        sf::FloatRect textBounds = text.getLocalBounds();
-        text.setOrigin(textBounds.left + textBounds.width / 2, textBounds.top + textBounds.height / 2);
-        text.setPosition(shape.getPosition());
+        text.setPosition(-radius / 2.5f, -radius / 1.5f);
     }
 
     bool isPocketed() const {
-        return pocketed;
+        return state->isPocketed(index);
     }
 
     // Setter untuk status pocketed
     void setPocketed(bool status) {
-        pocketed = status;
+        state->setFlag(index, BallPocketed, status);
     }
 
     bool isHit() const {
-        return hit;
+        return state->hasFlag(index, BallHit);
     }
 
     void setHit(bool hitStatus) {
-        hit = hitStatus;
+        state->setFlag(index, BallHit, hitStatus);
     }
 
     bool isCollidingWith(const Ball& other) const {
         // Menggunakan jarak Euclidean untuk mendeteksi tabrakan
-        float distance = std::sqrt(std::pow(shape.getPosition().x - other.shape.getPosition().x, 2) +
-                                   std::pow(shape.getPosition().y - other.shape.getPosition().y, 2));
-        float radiusSum = shape.getRadius() + other.shape.getRadius();
-        return distance <= radiusSum; // Jika jarak antara dua bola lebih kecil atau sama dengan jumlah radius, berarti tabrakan
+        sf::Vector2f delta = getPosition() - other.getPosition();
+        float radiusSum = getRadius() + other.getRadius();
+        return delta.x * delta.x + delta.y * delta.y <= radiusSum * radiusSum;
     }
 
     int getID() const {
         return id;
     }
 
+    int getIndex() const {
+        return index;
+    }
+
     sf::Color getColor() const {
         return color;
     }
@@ -80,92 +86,72 @@ public:
         return shape.getRadius();  
     }
 
-    void update(float deltaTime) {
-        sf::Vector2f newPosition = shape.getPosition() + velocity * deltaTime;
-
-        if (newPosition.x - BallRadius < TableBorder + OFFSET_X || newPosition.x + BallRadius > WindowWidth - TableBorder + OFFSET_X) {
-            velocity.x = -velocity.x;
-        }
-        if (newPosition.y - BallRadius < TableBorder + OFFSET_Y || newPosition.y + BallRadius > WindowHeight - TableBorder + OFFSET_Y) {
-            velocity.y = -velocity.y;
-        }
-
-        float friction = 0.99f;
-        velocity *= std::pow(friction, deltaTime * 120);
-
-        shape.setPosition(shape.getPosition() + velocity * deltaTime);
-
-        if (std::sqrt(velocity.x * velocity.x + velocity.y * velocity.y) < MinVelocity) {
-            velocity = sf::Vector2f(0.0f, 0.0f);
-        }
-
-        shape.setPosition(shape.getPosition() + velocity * deltaTime);
-        text.setPosition(shape.getPosition());
+    void applyForce(sf::Vector2f force) {
+        state->applyForce(index, force.x, force.y);
     }
 
-    void applyForce(sf::Vector2f force) {
-        velocity += force;
+    // Pukulan cue; hanya berlaku untuk bola putih.
+    void strike(const Shot& shot) {
+        applyShot(*state, shot);
     }
 
-    void draw(sf::RenderWindow& window, sf::Font& font) const {
-        window.draw(shape);
+    bool getStriped() const {
+        return isStriped;
+    }
 
+    // Gambar bola berpusat di titik asal transform. Dipakai BallRenderer untuk
+    // membuat atlas sekali saja, bukan setiap frame.
+    void drawSprite(sf::RenderTarget& target, const sf::Transform& transform) const {
+        target.draw(shape, transform);
         if (isStriped) {
-            sf::CircleShape centerCircle(BallRadius / 1.5);
-            centerCircle.setFillColor(sf::Color::White);
-            centerCircle.setPosition(shape.getPosition());
-            centerCircle.setOrigin(centerCircle.getRadius(), centerCircle.getRadius());
-            window.draw(centerCircle);
+            target.draw(stripe, transform);
         }
-
         if (id > 0) {
-            sf::Text number;
-            number.setFont(font);
-            number.setString(std::to_string(id));
-            number.setCharacterSize(18);
-            number.setStyle(sf::Text::Bold);
-
-            sf::Vector2f ballPosition = shape.getPosition();
-            number.setPosition(ballPosition.x - BallRadius / 2.5f, ballPosition.y - BallRadius / 1.5f);
-
-            if (id == 8) {
-                number.setFillColor(sf::Color::White);
-            } else {
-                number.setFillColor(sf::Color::Black);
-            }
-
-            window.draw(number);
+            target.draw(text, transform);
         }
     }
 
     sf::Vector2f getPosition() const {
-        return shape.getPosition();
+        return sf::Vector2f(state->posX[index] + OFFSET_X, state->posY[index] + OFFSET_Y);
+    }
+
+    sf::Vector2f getRenderPosition(float alpha) const {
+        return sf::Vector2f(state->renderX(index, alpha) + OFFSET_X, state->renderY(index, alpha) + OFFSET_Y);
     }
 
     sf::FloatRect getBounds() const {
-        return shape.getGlobalBounds();
+        float radius = getRadius();
+        sf::Vector2f position = getPosition();
+        return sf::FloatRect(position.x - radius, position.y - radius, radius * 2, radius * 2);
     }
 
     sf::Vector2f getVelocity() const {
-        return velocity;
+        return sf::Vector2f(state->velX[index], state->velY[index]);
     }
 
     void setVelocity(const sf::Vector2f& newVelocity) {
-        velocity = newVelocity;
+        state->velX[index] = newVelocity.x;
+        state->velY[index] = newVelocity.y;
     }
 
     void respawn() {
-        shape.setPosition(initialPosition + sf::Vector2f(OFFSET_X, OFFSET_Y));
-        velocity = sf::Vector2f(0.0f, 0.0f);
+        state->posX[index] = initialPosition.x;
+        state->posY[index] = initialPosition.y;
+        state->prevX[index] = initialPosition.x;
+        state->prevY[index] = initialPosition.y;
+        setVelocity(sf::Vector2f(0.0f, 0.0f));
+        setPocketed(false);
     }
 
     void setPosition(const sf::Vector2f& newPosition) {
-        shape.setPosition(newPosition + sf::Vector2f(OFFSET_X, OFFSET_Y));
-        text.setPosition(shape.getPosition());
+        state->posX[index] = newPosition.x;
+        state->posY[index] = newPosition.y;
+        state->prevX[index] = newPosition.x;
+        state->prevY[index] = newPosition.y;
     }
 
     bool isMoving() const {
-        return std::sqrt(velocity.x * velocity.x + velocity.y * velocity.y) > MinVelocity;
+        return state->isMoving(index);
     }
 
 };
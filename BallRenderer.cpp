@@ -0,0 +1,84 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "Constants.hpp"
+#include "Ball.cpp"
+#include "BallSlots.cpp"
+
+// Menggambar semua bola dengan satu draw call. Tampilan setiap bola (lingkaran,
+// garis strip, dan nomor) dipanggang sekali ke atlas tekstur; setiap frame hanya
+// posisi quad di VertexArray yang diperbarui, tanpa membuat objek SFML baru.
+class BallRenderer : public sf::Drawable {
+private:
+    static const int AtlasColumns = 4;
+
+    sf::RenderTexture atlas;
+    sf::VertexArray vertices;
+    std::vector<sf::Vector2f> cellOrigin; // indeks: ID bola
+    float cellSize;
+    float halfExtent;
+
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override {
+        states.texture = &atlas.getTexture();
+        target.draw(vertices, states);
+    }
+
+public:
+    explicit BallRenderer(const std::vector<Ball>& balls)
+        : vertices(sf::Triangles), halfExtent(0.0f) {
+        int maxId = 0;
+        for (const auto& ball : balls) {
+            maxId = std::max(maxId, ball.getID());
+            halfExtent = std::max(halfExtent, ball.getRadius() + 2.0f); // + garis tepi
+        }
+        cellSize = std::ceil(halfExtent * 2.0f) + 2.0f;
+        int rows = maxId / AtlasColumns + 1;
+
+        atlas.create(static_cast<unsigned>(cellSize * AtlasColumns), static_cast<unsigned>(cellSize * rows));
+        atlas.clear(sf::Color::Transparent);
+        cellOrigin.assign(maxId + 1, sf::Vector2f(0.0f, 0.0f));
+
+        for (const auto& ball : balls) {
+            int id = ball.getID();
+            sf::Vector2f origin((id % AtlasColumns) * cellSize, (id / AtlasColumns) * cellSize);
+            cellOrigin[id] = origin;
+
+            sf::Transform transform;
+            transform.translate(origin + sf::Vector2f(cellSize / 2, cellSize / 2));
+            ball.drawSprite(atlas, transform);
+        }
+        atlas.display();
+        atlas.setSmooth(true);
+
+        vertices.resize(balls.size() * 6);
+    }
+
+    // Tulis ulang quad setiap bola; kapasitas VertexArray dipakai ulang.
+    void update(const BallSlots<Ball>& balls, float alpha) {
+        vertices.resize(balls.size() * 6);
+
+        const float center = cellSize / 2;
+        std::size_t v = 0;
+        for (int i = balls.first(); i != -1; i = balls.next(i)) {
+            const Ball& ball = balls[i];
+            sf::Vector2f p = ball.getRenderPosition(alpha);
+            sf::Vector2f t = cellOrigin[ball.getID()] + sf::Vector2f(center, center);
+
+            const sf::Vector2f corners[4] = {
+                { -halfExtent, -halfExtent }, { halfExtent, -halfExtent },
+                { halfExtent, halfExtent }, { -halfExtent, halfExtent }
+            };
+            const int order[6] = { 0, 1, 2, 0, 2, 3 };
+            for (int k = 0; k < 6; ++k) {
+                vertices[v].position = p + corners[order[k]];
+                vertices[v].texCoords = t + corners[order[k]];
+                vertices[v].color = sf::Color::White;
+                ++v;
+            }
+        }
+        vertices.resize(v);
+    }
+};
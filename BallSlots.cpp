@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+inline int countTrailingZeros(std::uint64_t bits) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, bits);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(bits);
+#endif
+}
+
+// Penyimpanan bola dengan slot tetap: slot i selalu berisi bola dengan indeks
+// TableState i, jadi indeks tidak pernah bergeser. Bola yang masih di meja
+// ditandai di bitmask; memasukkan bola ke lubang hanya membalik satu bit, dan
+// iterasi melompati slot kosong dengan bit scan.
+template <typename T>
+class BallSlots {
+private:
+    std::vector<T> slots;
+    std::vector<std::uint64_t> active;
+
+    // Slot aktif pertama mulai dari slot start, atau -1.
+    int scan(int start) const {
+        std::size_t word = static_cast<std::size_t>(start) / 64;
+        if (word >= active.size()) return -1;
+
+        std::uint64_t bits = active[word] & (~std::uint64_t(0) << (start % 64));
+        while (bits == 0) {
+            if (++word == active.size()) return -1;
+            bits = active[word];
+        }
+        return static_cast<int>(word * 64) + countTrailingZeros(bits);
+    }
+
+public:
+    // Tambah bola di slot berikutnya (aktif); mengembalikan nomor slotnya.
+    int add(const T& ball) {
+        int slot = static_cast<int>(slots.size());
+        slots.push_back(ball);
+        if (static_cast<std::size_t>(slot) / 64 >= active.size()) active.push_back(0);
+        activate(slot);
+        return slot;
+    }
+
+    T& operator[](int slot) {
+        return slots[slot];
+    }
+
+    const T& operator[](int slot) const {
+        return slots[slot];
+    }
+
+    bool isActive(int slot) const {
+        return (active[slot / 64] >> (slot % 64)) & 1u;
+    }
+
+    void activate(int slot) {
+        active[slot / 64] |= std::uint64_t(1) << (slot % 64);
+    }
+
+    void deactivate(int slot) {
+        active[slot / 64] &= ~(std::uint64_t(1) << (slot % 64));
+    }
+
+    // Iterasi slot aktif: for (int i = balls.first(); i != -1; i = balls.next(i))
+    int first() const {
+        return scan(0);
+    }
+
+    int next(int slot) const {
+        return scan(slot + 1);
+    }
+
+    // Jumlah slot, termasuk yang tidak aktif.
+    std::size_t size() const {
+        return slots.size();
+    }
+
+    std::size_t activeCount() const {
+        std::size_t count = 0;
+        for (int i = first(); i != -1; i = next(i)) ++count;
+        return count;
+    }
+
+    // Semua slot, termasuk bola yang sudah masuk lubang.
+    const std::vector<T>& all() const {
+        return slots;
+    }
+};
@@ -1,20 +1,31 @@
 #ifndef CONSTANTS_HPP
 #define CONSTANTS_HPP
 
-const float TableWidth = 1000.0f;
-const float TableHeight = 550.0f;
-const float TableBorder = 40.0f;
-const float BallRadius = 18.0f;
-const float MinVelocity = 0.99f;
-const float VELOCITY_THRESHOLD = 0.01f;
-const float COLLISION_THRESHOLD = 0.1f;
+// Ukuran meja bawaan (ClassicTable); meja lain didefinisikan di TableConfig.cpp
+constexpr float TableWidth = 1000.0f;
+constexpr float TableHeight = 550.0f;
+constexpr float TableBorder = 40.0f;
+constexpr float BallRadius = 18.0f;
+constexpr float MinVelocity = 0.99f;
+constexpr float Friction = 0.99f;
+constexpr float MaxCueForce = 2000.0f;
+constexpr float CueForceScale = 2.0f;
+constexpr float PocketRadius = 25.0f;
+constexpr float PocketCaptureRadius = PocketRadius + BallRadius / 2;
+constexpr float PhysicsStepRate = 240.0f;
+constexpr int PhysicsSubsteps = 2;
+constexpr float VELOCITY_THRESHOLD = 0.01f;
+constexpr float COLLISION_THRESHOLD = 0.1f;
 
 
-const float WindowWidth = TableWidth + TableBorder * 2;
-const float WindowHeight = TableHeight + TableBorder * 2;
-const float BackWidth = WindowWidth + 300.0f;
-const float BackHeight = WindowHeight + 200.0f;
-const float OFFSET_X = (BackWidth - WindowWidth) / 2;
-const float OFFSET_Y = (BackHeight - WindowHeight) / 2;
+constexpr float WindowWidth = TableWidth + TableBorder * 2;
+constexpr float WindowHeight = TableHeight + TableBorder * 2;
+constexpr float BackWidth = WindowWidth + 300.0f;
+constexpr float BackHeight = WindowHeight + 200.0f;
+constexpr float OFFSET_X = (BackWidth - WindowWidth) / 2;
+constexpr float OFFSET_Y = (BackHeight - WindowHeight) / 2;
+
+// Batas frame rate saat ada animasi; saat meja diam loop utama menunggu input
+constexpr unsigned int FrameRateLimit = 120;
 
 #endif
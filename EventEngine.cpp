@@ -0,0 +1,430 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+#include "Constants.hpp"
+#include "TableState.cpp"
+#include "TableGeometry.cpp"
+#include "MotionSegment.cpp"
+#include "PhysicsEvents.cpp"
+
+// Mode simulasi berbasis event (continuous collision). Setiap bola bergerak
+// menurut MotionSegment, dan karena semua bola berbagi laju peluruhan yang
+// sama, perpindahannya sebanding dengan u(t) yang sama. Waktu tumbukan
+// bola-bola, bola-cushion, dan bola-lubang bisa dihitung secara analitik
+// (kuadrat dalam u). Meja melompat langsung dari event ke event, dan setelah
+// tumbukan hanya segmen dan event milik bola yang terlibat yang dihitung ulang,
+// jadi menjalankan satu pukulan sampai diam sebanding dengan jumlah event.
+class EventEngine {
+public:
+    enum EventType {
+        BallBall,
+        Cushion,
+        Pocket,
+        Rest
+    };
+
+    // Ringkasan satu event yang sudah diproses, untuk pemanggil processNext()
+    struct EventRecord {
+        EventType type;
+        int a;
+        int b;
+        double time;
+    };
+
+private:
+    struct Event {
+        double time;
+        EventType type;
+        int a;
+        int b;          // bola kedua, indeks cushion (rahang setelah semua segmen), atau indeks lubang
+        unsigned countA;
+        unsigned countB;
+
+        bool operator>(const Event& other) const {
+            return time > other.time;
+        }
+    };
+
+    TableState& state;
+    const TableGeometry& geometry;
+    double ballRadius;
+    std::vector<MotionSegment> motion;
+    std::vector<unsigned> eventCount;
+    // Min-heap event; vector biasa supaya reset() tidak melepas kapasitasnya
+    std::vector<Event> queue;
+    double now;
+    std::uint64_t processedEvents;
+    PhysicsEventStream* events;
+
+    const double decayRate;
+
+    static constexpr double infinity = std::numeric_limits<double>::infinity();
+
+    bool isResting(int i) const {
+        return motion[i].isResting();
+    }
+
+    void positionAt(int i, double time, double& x, double& y) const {
+        motion[i].positionAt(time, x, y);
+    }
+
+    void velocityAt(int i, double time, double& vx, double& vy) const {
+        motion[i].velocityAt(time, vx, vy);
+    }
+
+    // Pindahkan titik acuan gerak bola ke waktu sekarang.
+    void rebase(int i) {
+        double x, y, vx, vy;
+        positionAt(i, now, x, y);
+        velocityAt(i, now, vx, vy);
+        setMotion(i, x, y, vx, vy);
+    }
+
+    void setMotion(int i, double x, double y, double vx, double vy) {
+        motion[i] = MotionSegment::start(now, x, y, vx, vy, decayRate);
+    }
+
+    // Terbitkan event untuk bola a yang segmennya sudah di-rebase ke waktu sekarang.
+    void publish(PhysicsEventType type, int a, int b, double speed) {
+        if (!events) return;
+        StreamEventSink(*events, static_cast<std::uint64_t>(now * PhysicsStepRate))
+            .publish(type, a, b, static_cast<float>(motion[a].x0), static_cast<float>(motion[a].y0), static_cast<float>(speed));
+    }
+
+    void push(double time, EventType type, int a, int b) {
+        if (time == infinity) return;
+        Event event = { time, type, a, b, eventCount[a], (type == BallBall) ? eventCount[b] : 0u };
+        queue.push_back(event);
+        std::push_heap(queue.begin(), queue.end(), std::greater<Event>());
+    }
+
+    // Waktu paling awal saat |r0 + dv * u| mencapai radius, untuk u >= 0.
+    // Pasangan yang hampir tidak saling mendekat diabaikan; sisa pembulatan dari
+    // tumbukan sebelumnya bisa menghasilkan event berulang di waktu yang sama.
+    static double enteringDisplacement(double rx, double ry, double dvx, double dvy, double radius) {
+        double a = dvx * dvx + dvy * dvy;
+        double b = 2.0 * (rx * dvx + ry * dvy);
+        double c = rx * rx + ry * ry - radius * radius;
+        if (a == 0.0 || b >= -1e-6) return infinity;
+
+        double discriminant = b * b - 4.0 * a * c;
+        if (discriminant < 0.0) return infinity;
+
+        double u = (-b - std::sqrt(discriminant)) / (2.0 * a);
+        return std::max(u, 0.0);
+    }
+
+    double eventTime(double u, double horizon) const {
+        if (u == infinity) return infinity;
+        double time = now + MotionSegment::timeForDisplacement(decayRate, u);
+        return (time <= horizon) ? time : infinity;
+    }
+
+    void predictPair(int i, int j) {
+        if (isResting(i) && isResting(j)) return;
+
+        double xi, yi, xj, yj, vxi, vyi, vxj, vyj;
+        positionAt(i, now, xi, yi);
+        positionAt(j, now, xj, yj);
+        velocityAt(i, now, vxi, vyi);
+        velocityAt(j, now, vxj, vyj);
+
+        double u = enteringDisplacement(xj - xi, yj - yi, vxj - vxi, vyj - vyi, 2.0 * ballRadius);
+        double horizon = std::min(isResting(i) ? infinity : motion[i].stopTime,
+                                  isResting(j) ? infinity : motion[j].stopTime);
+        push(eventTime(u, horizon), BallBall, i, j);
+    }
+
+    void predict(int i) {
+        if (state.isPocketed(i) || isResting(i)) return;
+
+        const MotionSegment& m = motion[i];
+        const int count = static_cast<int>(state.size());
+
+        for (int j = 0; j < count; ++j) {
+            if (j != i && !state.isPocketed(j)) {
+                predictPair(i, j);
+            }
+        }
+
+        const std::vector<TableGeometry::Cushion>& cushions = geometry.getCushions();
+        const int cushionCount = static_cast<int>(cushions.size());
+        for (int k = 0; k < cushionCount; ++k) {
+            const TableGeometry::Cushion& c = cushions[k];
+            double approach = -(m.vx0 * c.nx + m.vy0 * c.ny);
+            if (approach <= 1e-9) continue;
+
+            double distance = (m.x0 - c.ax) * c.nx + (m.y0 - c.ay) * c.ny - ballRadius;
+            double u = std::max(distance, 0.0) / approach;
+            double along = (m.x0 + m.vx0 * u - c.ax) * c.tx + (m.y0 + m.vy0 * u - c.ay) * c.ty;
+            if (along >= 0.0 && along <= c.length) {
+                push(eventTime(u, m.stopTime), Cushion, i, k);
+            }
+        }
+
+        const std::vector<TableGeometry::Jaw>& jaws = geometry.getJaws();
+        for (int k = 0; k < static_cast<int>(jaws.size()); ++k) {
+            double u = enteringDisplacement(jaws[k].cx - m.x0, jaws[k].cy - m.y0, -m.vx0, -m.vy0, ballRadius + jaws[k].radius);
+            push(eventTime(u, m.stopTime), Cushion, i, cushionCount + k);
+        }
+
+        const std::vector<TableGeometry::Pocket>& pockets = geometry.getPockets();
+        for (int p = 0; p < static_cast<int>(pockets.size()); ++p) {
+            double u = enteringDisplacement(pockets[p].cx - m.x0, pockets[p].cy - m.y0, -m.vx0, -m.vy0,
+                                            std::sqrt(pockets[p].radiusSquared));
+            push(eventTime(u, m.stopTime), Pocket, i, p);
+        }
+
+        // Melewati garis cushion di mulut lubang juga berarti masuk lubang terdekat
+        double crossing = infinity;
+        if (m.vx0 < 0.0) crossing = std::min(crossing, std::max(m.x0 - geometry.getLeft(), 0.0) / -m.vx0);
+        if (m.vx0 > 0.0) crossing = std::min(crossing, std::max(geometry.getRight() - m.x0, 0.0) / m.vx0);
+        if (m.vy0 < 0.0) crossing = std::min(crossing, std::max(m.y0 - geometry.getTop(), 0.0) / -m.vy0);
+        if (m.vy0 > 0.0) crossing = std::min(crossing, std::max(geometry.getBottom() - m.y0, 0.0) / m.vy0);
+        if (crossing != infinity) {
+            int p = geometry.nearestPocket(static_cast<float>(m.x0 + m.vx0 * crossing), static_cast<float>(m.y0 + m.vy0 * crossing));
+            push(eventTime(crossing, m.stopTime), Pocket, i, p);
+        }
+
+        push(m.stopTime, Rest, i, 0);
+    }
+
+    Event popEvent() {
+        std::pop_heap(queue.begin(), queue.end(), std::greater<Event>());
+        Event event = queue.back();
+        queue.pop_back();
+        return event;
+    }
+
+    bool isValid(const Event& event) const {
+        if (event.countA != eventCount[event.a]) return false;
+        if (event.type == BallBall && event.countB != eventCount[event.b]) return false;
+        return true;
+    }
+
+    void process(const Event& event) {
+        const int i = event.a;
+        now = event.time;
+        ++processedEvents;
+
+        switch (event.type) {
+        case BallBall: {
+            const int j = event.b;
+            rebase(i);
+            rebase(j);
+
+            MotionSegment& mi = motion[i];
+            MotionSegment& mj = motion[j];
+            double nx = mj.x0 - mi.x0;
+            double ny = mj.y0 - mi.y0;
+            double distance = std::sqrt(nx * nx + ny * ny);
+            if (distance > 0.0) {
+                nx /= distance;
+                ny /= distance;
+                double speed = (mj.vx0 - mi.vx0) * nx + (mj.vy0 - mi.vy0) * ny;
+                if (speed < 0.0) {
+                    publish(EventBallHit, i, j, -speed);
+                    setMotion(i, mi.x0, mi.y0, mi.vx0 + nx * speed, mi.vy0 + ny * speed);
+                    setMotion(j, mj.x0, mj.y0, mj.vx0 - nx * speed, mj.vy0 - ny * speed);
+
+                    // Bola yang kecepatannya jatuh di bawah MinVelocity langsung diam; buang sisa
+                    // komponen yang masih mendekat supaya pasangan ini tidak bertumbukan lagi di waktu yang sama.
+                    double remaining = (mj.vx0 - mi.vx0) * nx + (mj.vy0 - mi.vy0) * ny;
+                    if (remaining < 0.0) {
+                        if (isResting(j)) {
+                            setMotion(i, mi.x0, mi.y0, mi.vx0 + nx * remaining, mi.vy0 + ny * remaining);
+                        } else {
+                            setMotion(j, mj.x0, mj.y0, mj.vx0 - nx * remaining, mj.vy0 - ny * remaining);
+                        }
+                    }
+                }
+            }
+            const bool firstContact = state.firstContact == -1;
+            state.recordHit(i, j);
+            if (firstContact && state.firstContact != -1) {
+                publish(EventFirstContact, CueBallIndex, state.firstContact, 0.0);
+            }
+            ++eventCount[i];
+            ++eventCount[j];
+            predict(i);
+            predict(j);
+            break;
+        }
+        case Cushion: {
+            rebase(i);
+            MotionSegment& m = motion[i];
+            const int cushionCount = static_cast<int>(geometry.getCushions().size());
+            double nx, ny;
+            if (event.b < cushionCount) {
+                nx = geometry.getCushions()[event.b].nx;
+                ny = geometry.getCushions()[event.b].ny;
+            } else {
+                const TableGeometry::Jaw& jaw = geometry.getJaws()[event.b - cushionCount];
+                nx = m.x0 - jaw.cx;
+                ny = m.y0 - jaw.cy;
+                double distance = std::sqrt(nx * nx + ny * ny);
+                nx /= distance;
+                ny /= distance;
+            }
+            double normalSpeed = m.vx0 * nx + m.vy0 * ny;
+            if (normalSpeed < 0.0) {
+                publish(EventCushionHit, i, (event.b < cushionCount) ? event.b : -1, -normalSpeed);
+                setMotion(i, m.x0, m.y0, m.vx0 - 2.0 * normalSpeed * nx, m.vy0 - 2.0 * normalSpeed * ny);
+            }
+            ++eventCount[i];
+            predict(i);
+            break;
+        }
+        case Pocket: {
+            rebase(i);
+            MotionSegment& m = motion[i];
+            publish(EventPocketed, i, event.b, std::sqrt(m.vx0 * m.vx0 + m.vy0 * m.vy0));
+            setMotion(i, m.x0, m.y0, 0.0, 0.0);
+            state.setFlag(i, BallPocketed, true);
+            ++eventCount[i];
+            break;
+        }
+        case Rest: {
+            rebase(i);
+            MotionSegment& m = motion[i];
+            setMotion(i, m.x0, m.y0, 0.0, 0.0);
+            publish(EventCameToRest, i, -1, 0.0);
+            ++eventCount[i];
+
+            // Event bola lain terhadap bola ini dihitung dengan batas waktu berhentinya; jadwalkan ulang.
+            const int count = static_cast<int>(state.size());
+            for (int j = 0; j < count; ++j) {
+                if (j != i && !state.isPocketed(j) && !isResting(j)) {
+                    predictPair(j, i);
+                }
+            }
+            break;
+        }
+        }
+    }
+
+    void writeState() {
+        const int count = static_cast<int>(state.size());
+        for (int i = 0; i < count; ++i) {
+            double x, y, vx, vy;
+            positionAt(i, now, x, y);
+            velocityAt(i, now, vx, vy);
+            state.posX[i] = static_cast<float>(x);
+            state.posY[i] = static_cast<float>(y);
+            state.velX[i] = static_cast<float>(vx);
+            state.velY[i] = static_cast<float>(vy);
+        }
+        state.storePrevious();
+    }
+
+public:
+    explicit EventEngine(TableState& table, const TableGeometry& tableGeometry = defaultTableGeometry(),
+                         float radius = BallRadius)
+        : state(table), geometry(tableGeometry), ballRadius(radius), now(0.0), processedEvents(0), events(nullptr),
+          decayRate(MotionSegment::frictionDecayRate()) {
+        reset();
+    }
+
+    // Pasang stream event (nullptr untuk melepas); stream harus hidup lebih lama dari engine ini.
+    void setEventStream(PhysicsEventStream* stream) {
+        events = stream;
+    }
+
+    // Baca ulang TableState (misalnya setelah pukulan cue atau respawn) dan jadwalkan ulang semua event.
+    // Waktu simulasi mulai lagi dari nol, supaya hasil pukulan tidak bergantung pada umur engine
+    // dan sama persis dengan engine baru yang dipakai replay.
+    void reset() {
+        const int count = static_cast<int>(state.size());
+        motion.resize(count);
+        eventCount.resize(count, 0);
+        queue.clear();
+        now = 0.0;
+
+        for (int i = 0; i < count; ++i) {
+            setMotion(i, state.posX[i], state.posY[i], state.velX[i], state.velY[i]);
+            ++eventCount[i];
+        }
+        for (int i = 0; i < count; ++i) {
+            predict(i);
+        }
+        writeState();
+    }
+
+    // Proses semua event sampai waktu simulasi mencapai time, lalu tulis posisi ke TableState.
+    void advanceTo(double time) {
+        while (!queue.empty() && queue.front().time <= time) {
+            Event event = popEvent();
+            if (isValid(event)) {
+                process(event);
+            }
+        }
+        now = std::max(now, time);
+        writeState();
+    }
+
+    int advance(float frameTime) {
+        std::uint64_t before = processedEvents;
+        advanceTo(now + frameTime);
+        return static_cast<int>(processedEvents - before);
+    }
+
+    // Lompat langsung ke keadaan diam; mengembalikan waktu simulasi saat semua bola berhenti.
+    double runToRest() {
+        while (!queue.empty()) {
+            Event event = popEvent();
+            if (isValid(event)) {
+                process(event);
+            }
+        }
+        writeState();
+        return now;
+    }
+
+    // Proses tepat satu event valid berikutnya. Mengembalikan false bila meja sudah diam.
+    // Posisi di TableState tidak ditulis; pakai positionOf()/velocityOf().
+    bool processNext(EventRecord& record) {
+        while (!queue.empty()) {
+            Event event = popEvent();
+            if (isValid(event)) {
+                process(event);
+                record.type = event.type;
+                record.a = event.a;
+                record.b = event.b;
+                record.time = event.time;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Segmen gerak bola i saat ini; berlaku sampai event berikutnya yang melibatkan bola i.
+    const MotionSegment& segmentOf(int i) const {
+        return motion[i];
+    }
+
+    void positionOf(int i, double& x, double& y) const {
+        positionAt(i, now, x, y);
+    }
+
+    void velocityOf(int i, double& vx, double& vy) const {
+        velocityAt(i, now, vx, vy);
+    }
+
+    // Posisi sudah tepat pada waktu sekarang, jadi tidak perlu interpolasi.
+    float alpha() const {
+        return 1.0f;
+    }
+
+    double getTime() const {
+        return now;
+    }
+
+    std::uint64_t getProcessedEvents() const {
+        return processedEvents;
+    }
+};
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "Constants.hpp"
+#include "TableState.cpp"
+#include "Physics.cpp"
+#include "TableConfig.cpp"
+#include "SleepIslands.cpp"
+#include "PhysicsEvents.cpp"
+
+// Jam simulasi dengan langkah tetap. Waktu frame dikumpulkan di accumulator
+// dan dihabiskan dalam langkah 1/stepRate detik, masing-masing dipecah menjadi
+// beberapa substep. Hasilnya sama persis untuk input yang sama, berapa pun
+// frame rate-nya. Real memilih presisi fisika (lihat Precision.cpp); waktu frame
+// tetap float karena hanya dipakai untuk menghitung jumlah langkah.
+// Config memilih meja (lihat TableConfig.cpp): tipe konfigurasi compile-time,
+// atau TableProfile bila meja baru diketahui saat runtime. Bola yang diam
+// ditidurkan (lihat SleepIslands.cpp) tanpa mengubah hasil simulasi. Bila
+// stream event dipasang, setiap langkah menerbitkan event fisikanya ke sana.
+template <typename Real, typename Config = ClassicTable>
+class BasicFixedStepClock {
+private:
+    BasicTableState<Real>& state;
+    Config config;
+    const TableGeometry& geometry;
+    UniformGrid grid;
+    BasicSleepIslands<Real> islands;
+    PhysicsEventStream* events;
+    std::vector<std::uint8_t> moving; // untuk EventCameToRest
+    float stepSize;
+    int substeps;
+    float accumulator;
+    float maxFrameTime;
+    std::uint64_t stepCount;
+
+    // EventCameToRest untuk bola bangun yang kecepatannya menjadi nol pada langkah ini.
+    void publishRest(const StreamEventSink& sink) {
+        moving.resize(state.size(), 0);
+        for (int i : islands.getAwake()) {
+            bool pocketed = state.isPocketed(i);
+            bool nowMoving = !pocketed && (state.velX[i] != Real(0) || state.velY[i] != Real(0));
+            if (moving[i] && !nowMoving && !pocketed) {
+                sink.publish(EventCameToRest, i, -1, static_cast<float>(state.posX[i]), static_cast<float>(state.posY[i]), 0.0f);
+            }
+            moving[i] = nowMoving;
+        }
+    }
+
+public:
+    BasicFixedStepClock(BasicTableState<Real>& table, float stepRate = PhysicsStepRate, int substepCount = PhysicsSubsteps)
+        : BasicFixedStepClock(table, Config(), tableGeometry<Config>(), stepRate, substepCount) {}
+
+    // tableGeometry harus dibuat dari tableConfig yang sama dan hidup lebih lama dari jam ini.
+    BasicFixedStepClock(BasicTableState<Real>& table, const Config& tableConfig, const TableGeometry& tableGeometry,
+                        float stepRate = PhysicsStepRate, int substepCount = PhysicsSubsteps)
+        : state(table), config(tableConfig), geometry(tableGeometry), grid(tableConfig), events(nullptr), stepSize(1.0f / stepRate),
+          substeps(std::max(1, substepCount)), accumulator(0.0f), maxFrameTime(0.25f), stepCount(0) {
+        state.storePrevious();
+    }
+
+    // Jalankan satu langkah tetap (tanpa accumulator), dipakai juga oleh replay dan AI.
+    void tick() {
+        islands.validate(state, grid);
+        state.storePrevious();
+        const Real substepSize(stepSize / substeps);
+        if (events) {
+            const StreamEventSink sink(*events, stepCount);
+            for (int i = 0; i < substeps; ++i) {
+                step(state, substepSize, grid, islands, geometry, config, sink);
+            }
+            publishRest(sink);
+        } else {
+            for (int i = 0; i < substeps; ++i) {
+                step(state, substepSize, grid, islands, geometry, config, NullEventSink());
+            }
+        }
+        islands.settle(state);
+        ++stepCount;
+    }
+
+    // Tambahkan waktu frame dan jalankan langkah yang sudah jatuh tempo.
+    // Frame yang tersendat dipotong ke maxFrameTime agar tidak terjadi lonjakan.
+    int advance(float frameTime) {
+        accumulator += std::min(frameTime, maxFrameTime);
+        int steps = 0;
+        while (accumulator >= stepSize) {
+            tick();
+            accumulator -= stepSize;
+            ++steps;
+        }
+        return steps;
+    }
+
+    // Faktor interpolasi render antara dua state fisika terakhir, di [0, 1).
+    float alpha() const {
+        return accumulator / stepSize;
+    }
+
+    float getStepSize() const {
+        return stepSize;
+    }
+
+    int getSubsteps() const {
+        return substeps;
+    }
+
+    std::uint64_t getStepCount() const {
+        return stepCount;
+    }
+
+    // Pasang stream event (nullptr untuk melepas); stream harus hidup lebih lama dari jam ini.
+    void setEventStream(PhysicsEventStream* stream) {
+        events = stream;
+        moving.clear();
+    }
+
+    // Tidur bola bisa dimatikan untuk perbandingan; hasil simulasi tetap sama.
+    void setSleeping(bool enabled) {
+        islands.setEnabled(enabled);
+    }
+
+    const BasicSleepIslands<Real>& getIslands() const {
+        return islands;
+    }
+};
+
+typedef BasicFixedStepClock<float> FixedStepClock;
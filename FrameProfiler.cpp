@@ -0,0 +1,192 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Profiler per fase frame. Aktifkan dengan -DBILLIARD_PROFILE; tanpa flag itu
+// semua makro PROFILE_* kosong sehingga tidak ada biaya sama sekali.
+enum ProfilePhase {
+    PhaseEvents,
+    PhaseIntegrate,
+    PhaseCollision,
+    PhasePockets,
+    PhaseRules,
+    PhaseDraw,
+    PhaseFrame,
+    PhaseCount
+};
+
+inline const char* profilePhaseName(int phase) {
+    static const char* const names[PhaseCount] = {
+        "events", "integrate", "collision", "pockets", "rules", "draw", "frame"
+    };
+    return names[phase];
+}
+
+class FrameProfiler {
+public:
+    struct Stats {
+        double min, p50, p99, max; // milidetik
+    };
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    struct TraceEvent {
+        std::uint8_t phase;
+        std::int64_t start; // nanodetik sejak profiler dibuat
+        std::int64_t duration;
+    };
+
+    static const int HistoryLength = 240;      // sekitar 4 detik pada 60 FPS
+    static const std::size_t MaxTraceEvents = 1 << 20;
+
+    Clock::time_point origin;
+    Clock::time_point frameStart;
+    std::thread::id owner;
+
+    std::array<std::int64_t, PhaseCount> current;
+    std::array<std::int64_t, PhaseCount> started;
+    std::array<std::array<float, HistoryLength>, PhaseCount> history;
+    int historyNext;
+    int historySize;
+
+    bool tracing;
+    std::vector<TraceEvent> trace;
+
+public:
+    FrameProfiler()
+        : origin(Clock::now()), frameStart(origin), owner(std::this_thread::get_id()),
+          history(), historyNext(0), historySize(0), tracing(false) {
+        current.fill(0);
+        started.fill(0);
+    }
+
+    std::int64_t now() const {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - origin).count();
+    }
+
+    void beginFrame() {
+        owner = std::this_thread::get_id();
+        frameStart = Clock::now();
+        current.fill(0);
+    }
+
+    void endFrame() {
+        std::int64_t start = std::chrono::duration_cast<std::chrono::nanoseconds>(frameStart - origin).count();
+        add(PhaseFrame, start, now());
+
+        for (int phase = 0; phase < PhaseCount; ++phase) {
+            history[phase][historyNext] = static_cast<float>(current[phase] * 1e-6);
+        }
+        historyNext = (historyNext + 1) % HistoryLength;
+        historySize = std::min(historySize + 1, HistoryLength);
+    }
+
+    // Catat satu interval; dari thread lain (AI, server) diabaikan.
+    void add(int phase, std::int64_t start, std::int64_t end) {
+        if (std::this_thread::get_id() != owner) return;
+
+        current[phase] += end - start;
+        if (tracing && trace.size() < MaxTraceEvents) {
+            trace.push_back(TraceEvent{ static_cast<std::uint8_t>(phase), start, end - start });
+        }
+    }
+
+    // Pasangan begin/end untuk blok datar di loop utama yang tidak punya scope sendiri.
+    void begin(int phase) {
+        started[phase] = now();
+    }
+
+    void end(int phase) {
+        add(phase, started[phase], now());
+    }
+
+    // min, p50, p99, dan max dari HistoryLength frame terakhir.
+    Stats stats(int phase) const {
+        Stats result = { 0.0, 0.0, 0.0, 0.0 };
+        if (historySize == 0) return result;
+
+        std::array<float, HistoryLength> sorted;
+        std::copy(history[phase].begin(), history[phase].begin() + historySize, sorted.begin());
+        std::sort(sorted.begin(), sorted.begin() + historySize);
+        result.min = sorted[0];
+        result.p50 = sorted[historySize / 2];
+        result.p99 = sorted[std::min(historySize - 1, historySize * 99 / 100)];
+        result.max = sorted[historySize - 1];
+        return result;
+    }
+
+    void startTrace() {
+        trace.clear();
+        tracing = true;
+    }
+
+    bool isTracing() const {
+        return tracing;
+    }
+
+    // Tulis event yang terkumpul dalam format trace_event Chrome (chrome://tracing, Perfetto).
+    bool stopTrace(const std::string& path) {
+        tracing = false;
+        std::FILE* file = std::fopen(path.c_str(), "w");
+        if (!file) return false;
+
+        std::fprintf(file, "{\"traceEvents\":[\n");
+        for (std::size_t k = 0; k < trace.size(); ++k) {
+            const TraceEvent& event = trace[k];
+            std::fprintf(file, "{\"name\":\"%s\",\"cat\":\"frame\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":1}%s\n",
+                         profilePhaseName(event.phase), event.start * 1e-3, event.duration * 1e-3,
+                         (k + 1 < trace.size()) ? "," : "");
+        }
+        std::fprintf(file, "],\"displayTimeUnit\":\"ms\"}\n");
+        std::fclose(file);
+        trace.clear();
+        return true;
+    }
+};
+
+inline FrameProfiler& frameProfiler() {
+    static FrameProfiler profiler;
+    return profiler;
+}
+
+// Mengukur satu blok kode sampai akhir scope.
+class ProfileScope {
+private:
+    int phase;
+    std::int64_t start;
+
+public:
+    explicit ProfileScope(int profiledPhase) : phase(profiledPhase), start(frameProfiler().now()) {}
+
+    ~ProfileScope() {
+        frameProfiler().add(phase, start, frameProfiler().now());
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+};
+
+#define BILLIARD_PROFILE_CONCAT2(a, b) a##b
+#define BILLIARD_PROFILE_CONCAT(a, b) BILLIARD_PROFILE_CONCAT2(a, b)
+
+#if defined(BILLIARD_PROFILE)
+#define PROFILE_SCOPE(phase) ProfileScope BILLIARD_PROFILE_CONCAT(profileScope, __LINE__)(phase)
+#define PROFILE_BEGIN(phase) frameProfiler().begin(phase)
+#define PROFILE_END(phase) frameProfiler().end(phase)
+#define PROFILE_FRAME_BEGIN() frameProfiler().beginFrame()
+#define PROFILE_FRAME_END() frameProfiler().endFrame()
+#else
+#define PROFILE_SCOPE(phase) ((void)0)
+#define PROFILE_BEGIN(phase) ((void)0)
+#define PROFILE_END(phase) ((void)0)
+#define PROFILE_FRAME_BEGIN() ((void)0)
+#define PROFILE_FRAME_END() ((void)0)
+#endif
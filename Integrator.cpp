@@ -0,0 +1,218 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include "Constants.hpp"
+#include "TableState.cpp"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define BILLIARD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(BILLIARD_X86) && (defined(__GNUC__) || defined(__clang__))
+#define BILLIARD_TARGET(name) __attribute__((target(name)))
+#else
+#define BILLIARD_TARGET(name)
+#endif
+
+// Faktor gesekan untuk satu langkah; sama untuk semua bola.
+inline float frictionDecay(float deltaTime) {
+    return std::pow(Friction, deltaTime * 120);
+}
+
+// Untuk double dan Fixed32 dihitung dalam double lalu dibulatkan ke Real. Untuk
+// Fixed32 hasil pow cukup dibulatkan ke 16 bit pecahan sehingga tetap sama di
+// semua platform; nilainya dihitung sekali per langkah, bukan per bola.
+template <typename Real>
+inline Real frictionDecay(Real deltaTime) {
+    return Real(std::pow(static_cast<double>(Friction), static_cast<double>(deltaTime) * 120.0));
+}
+
+// Gerak satu bola: gesekan dan batas kecepatan minimum.
+// Pantulan cushion ditangani TableGeometry setelah integrasi.
+template <typename Real>
+inline void integrateBall(BasicTableState<Real>& state, int i, Real deltaTime, Real decay) {
+    Real& x = state.posX[i];
+    Real& y = state.posY[i];
+    Real& vx = state.velX[i];
+    Real& vy = state.velY[i];
+
+    vx *= decay;
+    vy *= decay;
+
+    if (vx * vx + vy * vy < Real(MinVelocity * MinVelocity)) {
+        vx = Real(0);
+        vy = Real(0);
+    }
+
+    x += vx * deltaTime;
+    y += vy * deltaTime;
+}
+
+template <typename Real>
+inline void integrateScalar(BasicTableState<Real>& state, int begin, int end, Real deltaTime, Real decay) {
+    for (int i = begin; i < end; ++i) {
+        if (!state.isPocketed(i)) {
+            integrateBall(state, i, deltaTime, decay);
+        }
+    }
+}
+
+#if defined(BILLIARD_X86)
+
+// Versi SSE2 dari integrateBall untuk 4 bola sekaligus. Urutan operasinya sama
+// dengan versi skalar, jadi hasilnya identik bit per bit.
+BILLIARD_TARGET("sse2")
+inline int integrateSse(TableState& state, int count, float deltaTime, float decay) {
+    const __m128 dt = _mm_set1_ps(deltaTime);
+    const __m128 factor = _mm_set1_ps(decay);
+    const __m128 restSquared = _mm_set1_ps(MinVelocity * MinVelocity);
+
+    float* px = state.posX.data();
+    float* py = state.posY.data();
+    float* vxs = state.velX.data();
+    float* vys = state.velY.data();
+    const std::uint8_t* flags = state.flags.data();
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128i pocketed = _mm_set_epi32(flags[i + 3] & BallPocketed, flags[i + 2] & BallPocketed,
+                                               flags[i + 1] & BallPocketed, flags[i] & BallPocketed);
+        const __m128 active = _mm_castsi128_ps(_mm_cmpeq_epi32(pocketed, _mm_setzero_si128()));
+
+        __m128 x = _mm_loadu_ps(px + i);
+        __m128 y = _mm_loadu_ps(py + i);
+        __m128 vx = _mm_loadu_ps(vxs + i);
+        __m128 vy = _mm_loadu_ps(vys + i);
+
+        __m128 nvx = _mm_mul_ps(vx, factor);
+        __m128 nvy = _mm_mul_ps(vy, factor);
+
+        __m128 moving = _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(nvx, nvx), _mm_mul_ps(nvy, nvy)), restSquared);
+        nvx = _mm_and_ps(nvx, moving);
+        nvy = _mm_and_ps(nvy, moving);
+
+        __m128 nx = _mm_add_ps(x, _mm_mul_ps(nvx, dt));
+        __m128 ny = _mm_add_ps(y, _mm_mul_ps(nvy, dt));
+
+        // Bola yang sudah masuk lubang tidak diubah
+        _mm_storeu_ps(px + i, _mm_or_ps(_mm_and_ps(active, nx), _mm_andnot_ps(active, x)));
+        _mm_storeu_ps(py + i, _mm_or_ps(_mm_and_ps(active, ny), _mm_andnot_ps(active, y)));
+        _mm_storeu_ps(vxs + i, _mm_or_ps(_mm_and_ps(active, nvx), _mm_andnot_ps(active, vx)));
+        _mm_storeu_ps(vys + i, _mm_or_ps(_mm_and_ps(active, nvy), _mm_andnot_ps(active, vy)));
+    }
+    return i;
+}
+
+// Versi AVX2 untuk 8 bola sekaligus.
+BILLIARD_TARGET("avx2")
+inline int integrateAvx2(TableState& state, int count, float deltaTime, float decay) {
+    const __m256 dt = _mm256_set1_ps(deltaTime);
+    const __m256 factor = _mm256_set1_ps(decay);
+    const __m256 restSquared = _mm256_set1_ps(MinVelocity * MinVelocity);
+    const __m256i pocketBit = _mm256_set1_epi32(BallPocketed);
+
+    float* px = state.posX.data();
+    float* py = state.posY.data();
+    float* vxs = state.velX.data();
+    float* vys = state.velY.data();
+    const std::uint8_t* flags = state.flags.data();
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256i laneFlags = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(flags + i)));
+        const __m256 active = _mm256_castsi256_ps(
+            _mm256_cmpeq_epi32(_mm256_and_si256(laneFlags, pocketBit), _mm256_setzero_si256()));
+
+        __m256 x = _mm256_loadu_ps(px + i);
+        __m256 y = _mm256_loadu_ps(py + i);
+        __m256 vx = _mm256_loadu_ps(vxs + i);
+        __m256 vy = _mm256_loadu_ps(vys + i);
+
+        __m256 nvx = _mm256_mul_ps(vx, factor);
+        __m256 nvy = _mm256_mul_ps(vy, factor);
+
+        __m256 speedSquared = _mm256_add_ps(_mm256_mul_ps(nvx, nvx), _mm256_mul_ps(nvy, nvy));
+        __m256 moving = _mm256_cmp_ps(speedSquared, restSquared, _CMP_GE_OQ);
+        nvx = _mm256_and_ps(nvx, moving);
+        nvy = _mm256_and_ps(nvy, moving);
+
+        __m256 nx = _mm256_add_ps(x, _mm256_mul_ps(nvx, dt));
+        __m256 ny = _mm256_add_ps(y, _mm256_mul_ps(nvy, dt));
+
+        _mm256_storeu_ps(px + i, _mm256_blendv_ps(x, nx, active));
+        _mm256_storeu_ps(py + i, _mm256_blendv_ps(y, ny, active));
+        _mm256_storeu_ps(vxs + i, _mm256_blendv_ps(vx, nvx, active));
+        _mm256_storeu_ps(vys + i, _mm256_blendv_ps(vy, nvy, active));
+    }
+    return i;
+}
+
+inline bool cpuHasAvx2() {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_cpu_supports("avx2");
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return false;
+#endif
+}
+
+#endif
+
+enum IntegratorKind {
+    IntegratorScalar,
+    IntegratorSse,
+    IntegratorAvx2
+};
+
+// Dipilih sekali saat pertama dipakai berdasarkan kemampuan CPU.
+inline IntegratorKind detectIntegrator() {
+#if defined(BILLIARD_X86)
+    static const IntegratorKind kind = cpuHasAvx2() ? IntegratorAvx2 : IntegratorSse;
+    return kind;
+#else
+    return IntegratorScalar;
+#endif
+}
+
+inline const char* integratorName(IntegratorKind kind) {
+    switch (kind) {
+    case IntegratorAvx2: return "avx2";
+    case IntegratorSse: return "sse2";
+    default: return "scalar";
+    }
+}
+
+// Integrasi semua bola dalam satu batch; faktor gesekan dihitung sekali per langkah.
+inline void integrateAll(TableState& state, float deltaTime, IntegratorKind kind = detectIntegrator()) {
+    const int count = static_cast<int>(state.size());
+    const float decay = frictionDecay(deltaTime);
+    int done = 0;
+
+#if defined(BILLIARD_X86)
+    if (kind == IntegratorAvx2) {
+        done = integrateAvx2(state, count, deltaTime, decay);
+    } else if (kind == IntegratorSse) {
+        done = integrateSse(state, count, deltaTime, decay);
+    }
+#else
+    (void)kind;
+#endif
+
+    integrateScalar(state, done, count, deltaTime, decay);
+}
+
+// double dan Fixed32: versi skalar saja; jalur SIMD di atas khusus float.
+template <typename Real>
+inline void integrateAll(BasicTableState<Real>& state, Real deltaTime) {
+    integrateScalar(state, 0, static_cast<int>(state.size()), deltaTime, frictionDecay(deltaTime));
+}
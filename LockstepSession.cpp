@@ -0,0 +1,422 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <vector>
+#include "TableState.cpp"
+#include "Shot.cpp"
+#include "Replay.cpp"
+#include "MatchRules.cpp"
+
+inline void checksumMix(std::uint32_t& hash, const void* data, std::size_t size) {
+    const std::uint8_t* p = static_cast<const std::uint8_t*>(data);
+    for (std::size_t k = 0; k < size; ++k) {
+        hash = (hash ^ p[k]) * 16777619u;
+    }
+}
+
+// Checksum FNV-1a atas seluruh state meja (bit float apa adanya), dipakai
+// untuk membandingkan simulasi dua peer.
+inline std::uint32_t tableChecksum(const TableState& state) {
+    std::uint32_t hash = 2166136261u;
+    auto mix = [&hash](const void* data, std::size_t size) {
+        checksumMix(hash, data, size);
+    };
+    std::size_t n = state.size();
+    mix(state.posX.data(), n * sizeof(float));
+    mix(state.posY.data(), n * sizeof(float));
+    mix(state.velX.data(), n * sizeof(float));
+    mix(state.velY.data(), n * sizeof(float));
+    mix(state.flags.data(), n);
+    std::int32_t firstContact = state.firstContact;
+    mix(&firstContact, sizeof(firstContact));
+    return hash;
+}
+
+// Checksum meja diam ditambah aturan (giliran, grup, skor, pemenang).
+inline std::uint32_t matchChecksum(const TableState& state, const MatchRules& rules) {
+    std::uint32_t hash = tableChecksum(state);
+    std::uint8_t packed[MatchRules::PackedSize];
+    rules.pack(packed);
+    checksumMix(hash, packed, sizeof(packed));
+    return hash;
+}
+
+// Checksum ukuran meja (tanpa nama). Dikirim dalam Hello: peer dengan meja
+// berbeda akan desync di setiap pukulan, jadi koneksinya ditolak.
+inline std::uint32_t profileChecksum(const TableProfile& profile) {
+    std::uint32_t hash = 2166136261u;
+    for (int k = 0; k < 15; ++k) {
+        checksumMix(hash, replay::profileFloat(profile, k), sizeof(float));
+    }
+    std::int32_t counts[2] = { profile.ballCount, profile.rackStyle };
+    checksumMix(hash, counts, sizeof(counts));
+    return hash;
+}
+
+// Protokol lockstep dua pemain tanpa transport (lihat NetPeer.cpp untuk UDP).
+//
+// Yang dikirim hanya input pukulan. Pukulan selalu diambil saat meja diam, dan
+// langkah fisika pada meja diam tidak mengubah apa pun, jadi penerima cukup
+// menerapkan pukulan begitu mejanya sendiri diam; simulasi deterministik
+// menghasilkan meja yang sama tanpa perlu menyamakan jam kedua peer.
+//
+// Paket (little-endian):
+//   Hello     u8 tipe, u32 checksum profil meja
+//   Shot      u8 tipe, u32 nomor pukulan, u32 langkah fisika, u8 pemain,
+//             f32 sudut, f32 power, u32 checksum meja setelah impuls    (22 byte)
+//   Ack       u8 tipe, u32 nomor pukulan
+//   Hash      u8 tipe, u32 nomor pukulan, u8 giliran, u32 checksum meja diam dan aturan
+//   Request   u8 tipe (minta snapshot)
+//   Snapshot  u8 tipe, u32 nomor pukulan, u8 giliran, i32 first contact,
+//             u16 n, n * (f32 x, y, vx, vy, u8 flags), MatchRules::PackedSize byte aturan
+//
+// Pukulan dikirim ulang sampai di-ack. Setiap kali meja diam, kedua peer
+// bertukar hash meja dan aturan; host adalah otoritas, jadi bila berbeda
+// client mengganti meja dan aturannya dengan snapshot dari host.
+// Paket selain Hello diabaikan sampai Hello dengan checksum meja yang sama
+// diterima; bila berbeda, hasTableMismatch() bernilai true.
+class LockstepSession {
+public:
+    enum PacketType : std::uint8_t {
+        PacketHello = 1,
+        PacketShot,
+        PacketAck,
+        PacketHash,
+        PacketRequest,
+        PacketSnapshot
+    };
+
+private:
+    struct ShotMessage {
+        std::uint32_t frame;
+        std::uint8_t player;
+        Shot shot;
+        std::uint32_t checksum;
+    };
+
+    struct Outstanding {
+        std::uint32_t seq;
+        std::vector<std::uint8_t> packet;
+        double sentAt;
+    };
+
+    struct RestHash {
+        std::uint32_t checksum;
+        std::uint8_t turn;
+    };
+
+    static constexpr double ResendInterval = 0.1;
+    static constexpr double HelloInterval = 0.5;
+    static constexpr double HashInterval = 1.0;
+    static const std::size_t KeptHashes = 8;
+
+    TableState& state;
+    bool authority;
+    bool connected;
+    std::uint32_t tableHash;
+    bool tableMismatch;
+
+    std::uint32_t appliedShots;
+    std::map<std::uint32_t, ShotMessage> remoteShots;
+    std::deque<Outstanding> unacked;
+
+    std::map<std::uint32_t, RestHash> ownHashes;
+    std::map<std::uint32_t, RestHash> peerHashes;
+    std::int64_t hashedSeq;
+    double lastHashAt;
+    double lastHelloAt;
+
+    bool snapshotWanted;     // host: kirim snapshot saat meja diam; client: minta snapshot
+    double lastRequestAt;
+    bool corrected;
+    MatchRules correctedRules;
+    std::uint32_t desyncs;
+
+    std::vector<std::vector<std::uint8_t>> outgoing;
+    double now;
+
+    void send(std::vector<std::uint8_t> packet) {
+        outgoing.push_back(std::move(packet));
+    }
+
+    void sendHello() {
+        std::vector<std::uint8_t> packet;
+        replay::putU8(packet, PacketHello);
+        replay::putU32(packet, tableHash);
+        send(std::move(packet));
+    }
+
+    void sendAck(std::uint32_t seq) {
+        std::vector<std::uint8_t> packet;
+        replay::putU8(packet, PacketAck);
+        replay::putU32(packet, seq);
+        send(std::move(packet));
+    }
+
+    void sendHash(std::uint32_t seq, const RestHash& hash) {
+        std::vector<std::uint8_t> packet;
+        replay::putU8(packet, PacketHash);
+        replay::putU32(packet, seq);
+        replay::putU8(packet, hash.turn);
+        replay::putU32(packet, hash.checksum);
+        send(std::move(packet));
+    }
+
+    void sendSnapshot(const MatchRules& rules) {
+        std::vector<std::uint8_t> packet;
+        replay::putU8(packet, PacketSnapshot);
+        replay::putU32(packet, appliedShots);
+        replay::putU8(packet, static_cast<std::uint8_t>(rules.getCurrentPlayer()));
+        replay::putU32(packet, static_cast<std::uint32_t>(state.firstContact));
+        replay::putU16(packet, static_cast<std::uint16_t>(state.size()));
+        for (std::size_t i = 0; i < state.size(); ++i) {
+            replay::putF32(packet, state.posX[i]);
+            replay::putF32(packet, state.posY[i]);
+            replay::putF32(packet, state.velX[i]);
+            replay::putF32(packet, state.velY[i]);
+            replay::putU8(packet, state.flags[i]);
+        }
+        std::uint8_t packed[MatchRules::PackedSize];
+        rules.pack(packed);
+        packet.insert(packet.end(), packed, packed + MatchRules::PackedSize);
+        send(std::move(packet));
+    }
+
+    // Host memperbaiki client dengan snapshot; client meminta snapshot.
+    void desync() {
+        ++desyncs;
+        snapshotWanted = true;
+        lastRequestAt = -1.0;
+    }
+
+    void compareHash(std::uint32_t seq) {
+        auto own = ownHashes.find(seq);
+        auto peer = peerHashes.find(seq);
+        if (own == ownHashes.end() || peer == peerHashes.end()) return;
+
+        if (own->second.checksum != peer->second.checksum || own->second.turn != peer->second.turn) {
+            desync();
+        }
+        peerHashes.erase(peer);
+    }
+
+    void receiveShot(const std::uint8_t* p) {
+        std::uint32_t seq = replay::getU32(p + 1);
+        sendAck(seq);
+        if (seq <= appliedShots) return; // duplikat, atau bentrok dengan pukulan yang sudah diterapkan
+
+        ShotMessage message;
+        message.frame = replay::getU32(p + 5);
+        message.player = p[9];
+        message.shot.angle = replay::getF32(p + 10);
+        message.shot.power = replay::getF32(p + 14);
+        message.checksum = replay::getU32(p + 18);
+        remoteShots[seq] = message;
+    }
+
+    void receiveSnapshot(const std::uint8_t* p, std::size_t size) {
+        if (authority || size < 12) return;
+        std::uint32_t seq = replay::getU32(p + 1);
+        std::uint16_t balls = replay::getU16(p + 10);
+        const std::size_t rulesOffset = 12 + balls * replay::KeyframeBallSize;
+        if (seq < appliedShots || balls != state.size() || size < rulesOffset + MatchRules::PackedSize) return;
+
+        state.firstContact = static_cast<std::int32_t>(replay::getU32(p + 6));
+        const std::uint8_t* ball = p + 12;
+        for (int i = 0; i < balls; ++i, ball += replay::KeyframeBallSize) {
+            state.posX[i] = replay::getF32(ball);
+            state.posY[i] = replay::getF32(ball + 4);
+            state.velX[i] = replay::getF32(ball + 8);
+            state.velY[i] = replay::getF32(ball + 12);
+            state.flags[i] = ball[16];
+        }
+        state.storePrevious();
+
+        appliedShots = seq;
+        remoteShots.erase(remoteShots.begin(), remoteShots.upper_bound(seq));
+        ownHashes.clear();
+        peerHashes.clear();
+        hashedSeq = static_cast<std::int64_t>(seq) - 1; // hash ulang setelah meja diam
+        snapshotWanted = false;
+        corrected = true;
+        correctedRules = MatchRules::unpack(p + rulesOffset);
+    }
+
+public:
+    // host: true untuk host (pemain 1), yang snapshot-nya menang saat desync.
+    // profileHash: profileChecksum() meja lokal.
+    LockstepSession(TableState& table, bool host, std::uint32_t profileHash)
+        : state(table), authority(host), connected(false), tableHash(profileHash), tableMismatch(false),
+          appliedShots(0), hashedSeq(-1),
+          lastHashAt(0.0), lastHelloAt(-HelloInterval), snapshotWanted(false), lastRequestAt(0.0),
+          corrected(false), desyncs(0), now(0.0) {}
+
+    // Panggil setelah pemain lokal memukul (impuls sudah diterapkan ke state).
+    void shotTaken(const Shot& shot, std::uint32_t frame, int player) {
+        ++appliedShots;
+        std::vector<std::uint8_t> packet;
+        replay::putU8(packet, PacketShot);
+        replay::putU32(packet, appliedShots);
+        replay::putU32(packet, frame);
+        replay::putU8(packet, static_cast<std::uint8_t>(player));
+        replay::putF32(packet, shot.angle);
+        replay::putF32(packet, shot.power);
+        replay::putU32(packet, tableChecksum(state));
+        unacked.push_back(Outstanding{ appliedShots, packet, now });
+        send(std::move(packet));
+    }
+
+    // Terapkan pukulan lawan berikutnya bila meja lokal sudah diam. Mengembalikan
+    // true bila impuls diberikan; shot dan player berisi pukulan itu.
+    bool applyRemoteShot(Shot& shot, int& player) {
+        auto found = remoteShots.find(appliedShots + 1);
+        if (found == remoteShots.end() || state.anyMoving()) return false;
+
+        ShotMessage message = found->second;
+        remoteShots.erase(found);
+        ++appliedShots;
+        applyShot(state, message.shot);
+        if (tableChecksum(state) != message.checksum) {
+            desync();
+        }
+
+        shot = message.shot;
+        player = message.player;
+        return true;
+    }
+
+    bool hasRemoteShot() const {
+        return remoteShots.count(appliedShots + 1) != 0;
+    }
+
+    // Masukkan satu paket yang diterima dari peer.
+    void receive(const std::uint8_t* data, std::size_t size) {
+        if (size == 0) return;
+        if (data[0] == PacketHello) {
+            if (authority) sendHello();
+            if (size < 5 || replay::getU32(data + 1) != tableHash) {
+                tableMismatch = true;
+            } else {
+                connected = true;
+            }
+            return;
+        }
+        if (!connected) return;
+
+        switch (data[0]) {
+        case PacketShot:
+            if (size >= 22) receiveShot(data);
+            break;
+        case PacketAck:
+            if (size >= 5) {
+                std::uint32_t seq = replay::getU32(data + 1);
+                while (!unacked.empty() && unacked.front().seq <= seq) unacked.pop_front();
+            }
+            break;
+        case PacketHash:
+            if (size >= 10) {
+                std::uint32_t seq = replay::getU32(data + 1);
+                peerHashes[seq] = RestHash{ replay::getU32(data + 6), data[5] };
+                while (peerHashes.size() > KeptHashes) peerHashes.erase(peerHashes.begin());
+                compareHash(seq);
+            }
+            break;
+        case PacketRequest:
+            if (authority) snapshotWanted = true;
+            break;
+        case PacketSnapshot:
+            receiveSnapshot(data, size);
+            break;
+        default:
+            break;
+        }
+    }
+
+    // Panggil sekali per frame setelah aturan diproses. time: detik (naik monoton);
+    // rules: aturan lokal, ikut di-hash dan dikirim dalam snapshot.
+    void update(double time, const MatchRules& rules) {
+        now = time;
+
+        if (!connected && !authority && now - lastHelloAt >= HelloInterval) {
+            sendHello();
+            lastHelloAt = now;
+        }
+
+        for (Outstanding& shot : unacked) {
+            if (now - shot.sentAt >= ResendInterval) {
+                outgoing.push_back(shot.packet);
+                shot.sentAt = now;
+            }
+        }
+
+        bool resting = !state.anyMoving() && !hasRemoteShot();
+        if (resting && static_cast<std::int64_t>(appliedShots) > hashedSeq) {
+            hashedSeq = appliedShots;
+            RestHash hash = { matchChecksum(state, rules), static_cast<std::uint8_t>(rules.getCurrentPlayer()) };
+            ownHashes[appliedShots] = hash;
+            while (ownHashes.size() > KeptHashes) ownHashes.erase(ownHashes.begin());
+            sendHash(appliedShots, hash);
+            lastHashAt = now;
+            compareHash(appliedShots);
+        } else if (resting && now - lastHashAt >= HashInterval && ownHashes.count(appliedShots)) {
+            // Hash bisa hilang di jalan; ulangi selama meja diam
+            sendHash(appliedShots, ownHashes[appliedShots]);
+            lastHashAt = now;
+        }
+
+        if (snapshotWanted) {
+            if (authority && resting) {
+                sendSnapshot(rules);
+                snapshotWanted = false;
+            } else if (!authority && now - lastRequestAt >= ResendInterval) {
+                std::vector<std::uint8_t> packet;
+                replay::putU8(packet, PacketRequest);
+                send(std::move(packet));
+                lastRequestAt = now;
+            }
+        }
+    }
+
+    // Paket yang harus dikirim ke peer; dikosongkan oleh transport.
+    std::vector<std::vector<std::uint8_t>>& pending() {
+        return outgoing;
+    }
+
+    // true sekali setelah meja diganti snapshot host; rules berisi aturan dari host.
+    bool takeCorrection(MatchRules& rules) {
+        if (!corrected) return false;
+        corrected = false;
+        rules = correctedRules;
+        return true;
+    }
+
+    bool isConnected() const {
+        return connected;
+    }
+
+    // true bila peer memakai meja (--table) yang berbeda.
+    bool hasTableMismatch() const {
+        return tableMismatch;
+    }
+
+    bool isAuthority() const {
+        return authority;
+    }
+
+    // Pemain lokal: host pemain 1, client pemain 2.
+    int localPlayer() const {
+        return authority ? 1 : 2;
+    }
+
+    std::uint32_t getShotCount() const {
+        return appliedShots;
+    }
+
+    std::uint32_t getDesyncCount() const {
+        return desyncs;
+    }
+};
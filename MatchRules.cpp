@@ -0,0 +1,177 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include "Constants.hpp"
+#include "TableState.cpp"
+#include "Rules.cpp"
+
+enum PocketKind {
+    PocketCue,       // scratch: giliran pindah, bola putih harus dikembalikan
+    PocketEight,     // permainan selesai
+    PocketOwn,       // bola grup pemain yang sedang giliran
+    PocketOpponent   // bola grup lawan: giliran pindah
+};
+
+struct PocketResult {
+    PocketKind kind;
+    int scorer;        // pemain yang mendapat bola (1 atau 2), 0 untuk bola putih dan hitam
+    bool groupChosen;  // bola ini menentukan grup solid/striped
+};
+
+enum TurnResult {
+    TurnPlaying,   // bola putih masih bergerak, atau giliran sudah diputuskan
+    TurnContinue,  // ada bola masuk, pemain yang sama lanjut
+    TurnFoul,      // foul (lihat getLastFoul), giliran pindah
+    TurnMiss       // tidak ada bola masuk, giliran pindah
+};
+
+// Aturan 8-ball dari loop utama: giliran, grup tiap pemain, skor, dan pemenang.
+// Tidak bergantung pada SFML, jadi dipakai bersama oleh main.cpp dan server.
+class MatchRules {
+private:
+    int currentPlayer;
+    int player1Type;
+    int player2Type;
+    bool ballPocketed;
+    bool turnEnded;
+    int winner;
+    int scores[2];
+    Foul lastFoul;
+
+    static int other(int player) {
+        return (player == 1) ? 2 : 1;
+    }
+
+public:
+    MatchRules()
+        : currentPlayer(2), player1Type(-1), player2Type(-1), ballPocketed(false), turnEnded(false),
+          winner(0), scores{ 0, 0 }, lastFoul(NoFoul) {}
+
+    // Bola ballID baru saja masuk lubang; panggil sekali per bola.
+    PocketResult pocket(int ballID) {
+        PocketResult result = { PocketOwn, 0, false };
+
+        if (ballID == CueBallIndex) {
+            result.kind = PocketCue;
+            ballPocketed = true;
+            currentPlayer = other(currentPlayer);
+            return result;
+        }
+        if (ballID == 8) {
+            result.kind = PocketEight;
+            winner = other(currentPlayer);
+            return result;
+        }
+
+        int ballType = (ballID >= 1 && ballID <= 7) ? GroupSolid : GroupStriped;
+        int& ownType = (currentPlayer == 1) ? player1Type : player2Type;
+        int& otherType = (currentPlayer == 1) ? player2Type : player1Type;
+        if (ownType == -1) {
+            ownType = ballType;
+            otherType = (ballType == GroupSolid) ? GroupStriped : GroupSolid;
+            result.groupChosen = true;
+        }
+
+        if (ownType == ballType) {
+            result.scorer = currentPlayer;
+        } else {
+            result.kind = PocketOpponent;
+            currentPlayer = other(currentPlayer);
+            result.scorer = currentPlayer;
+        }
+        ++scores[result.scorer - 1];
+        ballPocketed = true;
+        return result;
+    }
+
+    // Panggil setiap frame setelah bola masuk diproses. Saat bola putih berhenti,
+    // giliran diputuskan sekali sampai bola putih dipukul lagi.
+    TurnResult update(const TableState& state) {
+        bool stopped = std::abs(state.velX[CueBallIndex]) < MinVelocity && std::abs(state.velY[CueBallIndex]) < MinVelocity;
+        TurnResult result = TurnPlaying;
+
+        if (stopped && !turnEnded) {
+            if (ballPocketed) {
+                ballPocketed = false;
+                result = TurnContinue;
+            } else {
+                lastFoul = checkFoul(state, getPlayerType(currentPlayer));
+                result = (lastFoul != NoFoul) ? TurnFoul : TurnMiss;
+                currentPlayer = other(currentPlayer);
+            }
+            turnEnded = true;
+        }
+
+        if (!stopped) {
+            turnEnded = false;
+        }
+        return result;
+    }
+
+    int getCurrentPlayer() const {
+        return currentPlayer;
+    }
+
+    // Giliran dari luar, misalnya pukulan lawan di mode jaringan.
+    void setCurrentPlayer(int player) {
+        currentPlayer = player;
+    }
+
+    // GroupSolid, GroupStriped, atau -1 bila belum dipilih.
+    int getPlayerType(int player) const {
+        return (player == 1) ? player1Type : player2Type;
+    }
+
+    bool isTurnEnded() const {
+        return turnEnded;
+    }
+
+    // Pemenang (1 atau 2), 0 selama permainan berlangsung.
+    int getWinner() const {
+        return winner;
+    }
+
+    int getScore(int player) const {
+        return scores[player - 1];
+    }
+
+    Foul getLastFoul() const {
+        return lastFoul;
+    }
+
+    // Seluruh keadaan aturan dalam PackedSize byte, untuk snapshot dan hash lockstep.
+    static constexpr std::size_t PackedSize = 9;
+
+    void pack(std::uint8_t* out) const {
+        out[0] = static_cast<std::uint8_t>(currentPlayer);
+        out[1] = static_cast<std::uint8_t>(static_cast<std::int8_t>(player1Type));
+        out[2] = static_cast<std::uint8_t>(static_cast<std::int8_t>(player2Type));
+        out[3] = ballPocketed ? 1 : 0;
+        out[4] = turnEnded ? 1 : 0;
+        out[5] = static_cast<std::uint8_t>(winner);
+        out[6] = static_cast<std::uint8_t>(scores[0]);
+        out[7] = static_cast<std::uint8_t>(scores[1]);
+        out[8] = static_cast<std::uint8_t>(lastFoul);
+    }
+
+    static MatchRules unpack(const std::uint8_t* in) {
+        MatchRules rules;
+        rules.currentPlayer = in[0];
+        rules.player1Type = static_cast<std::int8_t>(in[1]);
+        rules.player2Type = static_cast<std::int8_t>(in[2]);
+        rules.ballPocketed = in[3] != 0;
+        rules.turnEnded = in[4] != 0;
+        rules.winner = in[5];
+        rules.scores[0] = in[6];
+        rules.scores[1] = in[7];
+        rules.lastFoul = static_cast<Foul>(in[8]);
+        return rules;
+    }
+
+    friend bool operator==(const MatchRules& a, const MatchRules& b) {
+        return a.currentPlayer == b.currentPlayer && a.player1Type == b.player1Type && a.player2Type == b.player2Type &&
+               a.ballPocketed == b.ballPocketed && a.turnEnded == b.turnEnded && a.winner == b.winner &&
+               a.scores[0] == b.scores[0] && a.scores[1] == b.scores[1] && a.lastFoul == b.lastFoul;
+    }
+};
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "Constants.hpp"
+
+// Gerak satu bola di antara dua event dalam bentuk tertutup. Gesekan membuat
+// kecepatan meluruh eksponensial, v(t) = v0 * e^(-k (t - t0)), sehingga
+// posisi p(t) = p0 + v0 * u(t - t0) dengan u(dt) = (1 - e^(-k dt)) / k.
+// Bola berhenti saat |v| turun ke MinVelocity; waktu itu dihitung sekali
+// saat segmen dibuat, dan posisi kapan pun dievaluasi langsung tanpa
+// mengintegrasikan frame demi frame.
+struct MotionSegment {
+    double t0;
+    double x0, y0;
+    double vx0, vy0;
+    double decayRate;  // k, per detik
+    double stopTime;   // t0 untuk bola diam
+
+    // Laju peluruhan yang setara dengan velocity *= Friction setiap 1/120 detik.
+    static double frictionDecayRate() {
+        return -120.0 * std::log(static_cast<double>(Friction));
+    }
+
+    // Perpindahan relatif u setelah dt detik (tanpa batas waktu berhenti).
+    static double displacement(double decayRate, double dt) {
+        return (1.0 - std::exp(-decayRate * dt)) / decayRate;
+    }
+
+    // Kebalikan displacement(): waktu untuk menempuh u, tak hingga bila tidak tercapai.
+    static double timeForDisplacement(double decayRate, double u) {
+        double remaining = 1.0 - decayRate * u;
+        if (remaining <= 0.0) return std::numeric_limits<double>::infinity();
+        return -std::log(remaining) / decayRate;
+    }
+
+    // Segmen baru yang dimulai pada time; kecepatan di bawah MinVelocity berarti diam.
+    static MotionSegment start(double time, double x, double y, double vx, double vy, double decayRate) {
+        MotionSegment m = { time, x, y, vx, vy, decayRate, time };
+        double speed = std::sqrt(vx * vx + vy * vy);
+        if (speed > MinVelocity) {
+            m.stopTime = time + std::log(speed / MinVelocity) / decayRate;
+        } else {
+            m.vx0 = 0.0;
+            m.vy0 = 0.0;
+        }
+        return m;
+    }
+
+    bool isResting() const {
+        return vx0 == 0.0 && vy0 == 0.0;
+    }
+
+    void positionAt(double time, double& x, double& y) const {
+        double u = displacement(decayRate, std::min(time, stopTime) - t0);
+        x = x0 + vx0 * u;
+        y = y0 + vy0 * u;
+    }
+
+    void velocityAt(double time, double& vx, double& vy) const {
+        if (time >= stopTime) {
+            vx = 0.0;
+            vy = 0.0;
+            return;
+        }
+        double decay = std::exp(-decayRate * (time - t0));
+        vx = vx0 * decay;
+        vy = vy0 * decay;
+    }
+
+    // Posisi akhir bila tidak ada event lain sebelum bola berhenti.
+    void restPosition(double& x, double& y) const {
+        positionAt(stopTime, x, y);
+    }
+};
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <SFML/Network.hpp>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+#include "LockstepSession.cpp"
+
+// Transport UDP untuk LockstepSession. Host membuka port tetap dan mengenali
+// client dari datagram pertama yang masuk; client mengirim ke alamat host.
+// Socket non-blocking, jadi pump() bisa dipanggil setiap frame tanpa menunggu.
+class NetPeer {
+private:
+    sf::UdpSocket socket;
+    sf::IpAddress peerAddress;
+    unsigned short peerPort;
+    bool hasPeer;
+    LockstepSession& session;
+    std::vector<std::uint8_t> buffer;
+
+public:
+    explicit NetPeer(LockstepSession& lockstep)
+        : peerPort(0), hasPeer(false), session(lockstep), buffer(sf::UdpSocket::MaxDatagramSize) {
+        socket.setBlocking(false);
+    }
+
+    bool host(unsigned short port) {
+        if (socket.bind(port) != sf::Socket::Done) {
+            std::cerr << "Port " << port << " tidak bisa dibuka\n";
+            return false;
+        }
+        std::cout << "Menunggu lawan di port " << port << "..." << std::endl;
+        return true;
+    }
+
+    bool join(const sf::IpAddress& address, unsigned short port) {
+        if (socket.bind(sf::Socket::AnyPort) != sf::Socket::Done) {
+            std::cerr << "Socket UDP tidak bisa dibuka\n";
+            return false;
+        }
+        peerAddress = address;
+        peerPort = port;
+        hasPeer = true;
+        std::cout << "Menghubungi " << address.toString() << ":" << port << "..." << std::endl;
+        return true;
+    }
+
+    // Terima semua datagram yang menunggu, perbarui sesi, lalu kirim paket keluar.
+    void pump(double time, const MatchRules& rules) {
+        std::size_t received = 0;
+        sf::IpAddress sender;
+        unsigned short senderPort = 0;
+        while (socket.receive(buffer.data(), buffer.size(), received, sender, senderPort) == sf::Socket::Done) {
+            if (!hasPeer) {
+                peerAddress = sender;
+                peerPort = senderPort;
+                hasPeer = true;
+                std::cout << "Lawan terhubung dari " << sender.toString() << ":" << senderPort << "." << std::endl;
+            }
+            if (sender != peerAddress || senderPort != peerPort) continue;
+            session.receive(buffer.data(), received);
+        }
+
+        session.update(time, rules);
+
+        std::vector<std::vector<std::uint8_t>>& outgoing = session.pending();
+        if (hasPeer) {
+            for (const std::vector<std::uint8_t>& packet : outgoing) {
+                socket.send(packet.data(), packet.size(), peerAddress, peerPort);
+            }
+        }
+        outgoing.clear();
+    }
+};
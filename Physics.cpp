@@ -0,0 +1,161 @@
+#pragma once
+
+#include <cmath>
+#include "Constants.hpp"
+#include "TableState.cpp"
+#include "UniformGrid.cpp"
+#include "Integrator.cpp"
+#include "TableGeometry.cpp"
+#include "TableConfig.cpp"
+#include "SleepIslands.cpp"
+#include "PhysicsEvents.cpp"
+#include "FrameProfiler.cpp"
+
+// Tumbukan elastis antara bola i dan j (massa sama). Dengan konfigurasi
+// compile-time (ClassicTable, Table9ft, ...) radius bola menjadi konstanta.
+// Tumbukan dan kontak pertama bola putih diterbitkan ke sink.
+template <typename Real, typename Config, typename Sink>
+inline void resolveCollision(BasicTableState<Real>& state, int i, int j, const Config& config, const Sink& sink) {
+    Real dx = state.posX[j] - state.posX[i];
+    Real dy = state.posY[j] - state.posY[i];
+    Real distanceSquared = dx * dx + dy * dy;
+
+    if (distanceSquared < Real(4 * config.ballRadius * config.ballRadius) && distanceSquared > Real(0)) {
+        Real distance = squareRoot(distanceSquared);
+        dx /= distance;
+        dy /= distance;
+
+        Real relVx = state.velX[j] - state.velX[i];
+        Real relVy = state.velY[j] - state.velY[i];
+        Real speed = relVx * dx + relVy * dy;
+
+        if (speed < Real(0)) {
+            const Real radius(config.ballRadius);
+            Real impulse = Real(2) * speed / (Real(1) / radius + Real(1) / radius);
+            Real ix = dx * impulse / radius;
+            Real iy = dy * impulse / radius;
+
+            state.velX[i] += ix;
+            state.velY[i] += iy;
+            state.velX[j] -= ix;
+            state.velY[j] -= iy;
+
+            const bool firstContact = state.firstContact == -1;
+            state.recordHit(i, j);
+            sink.publish(EventBallHit, i, j, static_cast<float>(state.posX[i]), static_cast<float>(state.posY[i]),
+                         -static_cast<float>(speed));
+            if (firstContact && state.firstContact != -1) {
+                sink.publish(EventFirstContact, CueBallIndex, state.firstContact,
+                             static_cast<float>(state.posX[CueBallIndex]), static_cast<float>(state.posY[CueBallIndex]),
+                             -static_cast<float>(speed));
+            }
+        }
+    }
+}
+
+template <typename Real, typename Config>
+inline void resolveCollision(BasicTableState<Real>& state, int i, int j, const Config& config) {
+    resolveCollision(state, i, j, config, NullEventSink());
+}
+
+template <typename Real>
+inline void resolveCollision(BasicTableState<Real>& state, int i, int j) {
+    resolveCollision(state, i, j, ClassicTable());
+}
+
+// Cushion, rahang, dan lubang untuk semua bola yang masih di meja.
+template <typename Real, typename Config>
+inline void collideTable(BasicTableState<Real>& state, const TableGeometry& geometry, const Config& config) {
+    const int count = static_cast<int>(state.size());
+    for (int i = 0; i < count; ++i) {
+        if (!state.isPocketed(i)) {
+            geometry.collideBall(state, i, config.ballRadius);
+        }
+    }
+}
+
+template <typename Real>
+inline void collideTable(BasicTableState<Real>& state, const TableGeometry& geometry) {
+    collideTable(state, geometry, ClassicTable());
+}
+
+// Maju satu langkah simulasi dengan semua pasangan bola (O(n^2)); tidak membutuhkan window.
+// Untuk hasil yang deterministik, panggil lewat FixedStepClock.
+template <typename Real>
+inline void step(BasicTableState<Real>& state, Real deltaTime) {
+    const int count = static_cast<int>(state.size());
+
+    {
+        PROFILE_SCOPE(PhaseIntegrate);
+        integrateAll(state, deltaTime);
+    }
+    PROFILE_SCOPE(PhaseCollision);
+    collideTable(state, defaultTableGeometry());
+    for (int i = 0; i < count; ++i) {
+        if (state.isPocketed(i)) continue;
+        for (int j = i + 1; j < count; ++j) {
+            if (!state.isPocketed(j)) {
+                resolveCollision(state, i, j);
+            }
+        }
+    }
+}
+
+// Sama seperti step(), tetapi pasangan kandidat diambil dari broadphase grid,
+// untuk meja dengan konfigurasi config dan geometry yang sesuai.
+template <typename Real, typename Config>
+inline void step(BasicTableState<Real>& state, Real deltaTime, UniformGrid& grid,
+                 const TableGeometry& geometry, const Config& config) {
+    {
+        PROFILE_SCOPE(PhaseIntegrate);
+        integrateAll(state, deltaTime);
+    }
+    PROFILE_SCOPE(PhaseCollision);
+    collideTable(state, geometry, config);
+    grid.update(state);
+    grid.forEachPair([&state, &config](int i, int j) {
+        resolveCollision(state, i, j, config);
+    });
+}
+
+// Seperti di atas, tetapi hanya bola yang bangun di islands yang disentuh. Bola
+// tidur di dekat bola bergerak dibangunkan sebelum pasangan diuji; pasangan
+// dua bola tidur tidak pernah dibuat. Lihat SleepIslands.cpp. Tumbukan,
+// pantulan, dan bola masuk diterbitkan ke sink (lihat PhysicsEvents.cpp).
+template <typename Real, typename Config, typename Sink>
+inline void step(BasicTableState<Real>& state, Real deltaTime, UniformGrid& grid, BasicSleepIslands<Real>& islands,
+                 const TableGeometry& geometry, const Config& config, const Sink& sink) {
+    {
+        PROFILE_SCOPE(PhaseIntegrate);
+        const std::vector<int>& awake = islands.getAwake();
+        if (awake.size() * 2 > state.size()) {
+            // Kecepatan bola tidur nol, jadi batch SIMD penuh tidak mengubahnya
+            integrateAll(state, deltaTime);
+        } else {
+            const Real decay = frictionDecay(deltaTime);
+            for (int i : awake) {
+                if (!state.isPocketed(i)) {
+                    integrateBall(state, i, deltaTime, decay);
+                }
+            }
+        }
+    }
+    PROFILE_SCOPE(PhaseCollision);
+    for (int i : islands.getAwake()) {
+        if (!state.isPocketed(i)) {
+            geometry.collideBall(state, i, config.ballRadius, sink);
+        }
+    }
+    grid.update(state, islands.getAwake());
+    islands.wake(state, grid, 2 * config.ballRadius);
+    grid.forEachPair(islands.getAwake(), [&islands](int j) {
+        return islands.isAwake(j);
+    }, [&state, &config, &sink](int i, int j) {
+        resolveCollision(state, i, j, config, sink);
+    });
+}
+
+template <typename Real>
+inline void step(BasicTableState<Real>& state, Real deltaTime, UniformGrid& grid) {
+    step(state, deltaTime, grid, defaultTableGeometry(), ClassicTable());
+}
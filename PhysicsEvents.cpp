@@ -0,0 +1,195 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// Event yang diterbitkan langkah fisika. Pemakai (aturan, overlay, statistik,
+// log pukulan) cukup bereaksi pada event ini alih-alih memindai seluruh meja
+// setiap frame.
+enum PhysicsEventType : std::uint8_t {
+    EventFirstContact,  // a = bola putih, b = bola pertama yang disentuh sejak pukulan
+    EventBallHit,       // a, b = dua bola; speed = laju relatif sepanjang garis tumbukan
+    EventCushionHit,    // a = bola, b = indeks cushion atau -1 untuk rahang; speed = laju normal
+    EventPocketed,      // a = bola, b = indeks lubang
+    EventCameToRest     // a = bola
+};
+
+struct PhysicsEvent {
+    std::uint32_t step;     // langkah fisika tetap; mode event-driven memakai waktu * PhysicsStepRate
+    PhysicsEventType type;
+    std::int16_t a;
+    std::int16_t b;
+    float x, y;             // posisi bola a saat event
+    float speed;
+};
+
+static_assert(sizeof(PhysicsEvent) == 24, "PhysicsEvent disalin sebagai tiga word 64-bit");
+
+inline const char* physicsEventName(PhysicsEventType type) {
+    switch (type) {
+    case EventFirstContact: return "first_contact";
+    case EventBallHit: return "ball_hit";
+    case EventCushionHit: return "cushion_hit";
+    case EventPocketed: return "pocketed";
+    default: return "came_to_rest";
+    }
+}
+
+// Ring buffer event dengan satu produser (thread fisika) dan berapa pun
+// pembaca. Semua slot dialokasikan sekali di konstruktor; publish() tidak
+// pernah menunggu maupun mengalokasi. Setiap pembaca punya kursor sendiri dan
+// membaca tanpa lock; pembaca yang tertinggal lebih dari kapasitas kehilangan
+// event tertua dan jumlahnya dicatat di getDropped().
+//
+// Setiap slot dilindungi nomor urut (seqlock): produser mengosongkan nomor,
+// menulis isi, lalu menerbitkan nomor baru. Pembaca yang melihat nomor berubah
+// di tengah pembacaan tahu slot itu sudah ditimpa.
+class PhysicsEventStream {
+private:
+    static const int Words = sizeof(PhysicsEvent) / sizeof(std::uint64_t);
+
+    struct Slot {
+        std::atomic<std::uint64_t> sequence; // indeks event + 1, 0 saat sedang ditulis
+        std::atomic<std::uint64_t> words[Words];
+    };
+
+    std::vector<Slot> slots;
+    std::uint64_t mask;
+    alignas(64) std::atomic<std::uint64_t> head;
+
+    static std::size_t roundCapacity(std::size_t capacity) {
+        std::size_t size = 1;
+        while (size < capacity) size <<= 1;
+        return size;
+    }
+
+    bool read(std::uint64_t index, PhysicsEvent& event) const {
+        const Slot& slot = slots[index & mask];
+        if (slot.sequence.load(std::memory_order_acquire) != index + 1) return false;
+
+        std::uint64_t words[Words];
+        for (int k = 0; k < Words; ++k) {
+            words[k] = slot.words[k].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != index + 1) return false;
+
+        std::memcpy(&event, words, sizeof(event));
+        return true;
+    }
+
+public:
+    // Kapasitas dibulatkan ke pangkat dua.
+    explicit PhysicsEventStream(std::size_t capacity = 4096)
+        : slots(roundCapacity(capacity)), mask(roundCapacity(capacity) - 1), head(0) {}
+
+    PhysicsEventStream(const PhysicsEventStream&) = delete;
+    PhysicsEventStream& operator=(const PhysicsEventStream&) = delete;
+
+    // Hanya dari thread produser.
+    void publish(const PhysicsEvent& event) {
+        const std::uint64_t index = head.load(std::memory_order_relaxed);
+        Slot& slot = slots[index & mask];
+
+        std::uint64_t words[Words];
+        std::memcpy(words, &event, sizeof(event));
+
+        slot.sequence.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (int k = 0; k < Words; ++k) {
+            slot.words[k].store(words[k], std::memory_order_relaxed);
+        }
+        slot.sequence.store(index + 1, std::memory_order_release);
+        head.store(index + 1, std::memory_order_release);
+    }
+
+    // Jumlah event yang pernah diterbitkan.
+    std::uint64_t getPublished() const {
+        return head.load(std::memory_order_acquire);
+    }
+
+    std::size_t getCapacity() const {
+        return slots.size();
+    }
+
+    // Kursor baca milik satu pemakai; boleh dipakai dari thread mana pun, satu thread per Reader.
+    class Reader {
+    private:
+        const PhysicsEventStream* stream;
+        std::uint64_t cursor;
+        std::uint64_t dropped;
+
+    public:
+        Reader() : stream(nullptr), cursor(0), dropped(0) {}
+        Reader(const PhysicsEventStream& source, std::uint64_t start) : stream(&source), cursor(start), dropped(0) {}
+
+        // Panggil callback(event) untuk setiap event baru, urut terbit. Mengembalikan jumlahnya.
+        template <typename Callback>
+        std::size_t drain(Callback&& callback) {
+            if (!stream) return 0;
+            std::size_t count = 0;
+            const std::uint64_t end = stream->getPublished();
+            while (cursor < end) {
+                PhysicsEvent event;
+                if (!stream->read(cursor, event)) {
+                    // Slot sudah ditimpa: lompat ke event tertua yang masih ada
+                    std::uint64_t oldest = stream->getPublished() - stream->getCapacity();
+                    std::uint64_t next = std::max(cursor + 1, oldest);
+                    dropped += next - cursor;
+                    cursor = next;
+                    continue;
+                }
+                callback(event);
+                ++cursor;
+                ++count;
+            }
+            return count;
+        }
+
+        // Lewati semua event yang belum dibaca.
+        void skip() {
+            if (stream) cursor = stream->getPublished();
+        }
+
+        std::uint64_t getDropped() const {
+            return dropped;
+        }
+    };
+
+    // Pembaca baru mulai dari event berikutnya yang akan diterbitkan.
+    Reader reader() const {
+        return Reader(*this, getPublished());
+    }
+};
+
+// Penerima event untuk step() dan TableGeometry::collideBall(). NullEventSink
+// dipakai bila tidak ada stream; semua panggilannya hilang saat kompilasi.
+struct NullEventSink {
+    void publish(PhysicsEventType, int, int, float, float, float) const {}
+};
+
+// Meneruskan event ke stream dengan nomor langkah saat ini.
+class StreamEventSink {
+private:
+    PhysicsEventStream* stream;
+    std::uint32_t step;
+
+public:
+    StreamEventSink(PhysicsEventStream& target, std::uint64_t physicsStep)
+        : stream(&target), step(static_cast<std::uint32_t>(physicsStep)) {}
+
+    void publish(PhysicsEventType type, int a, int b, float x, float y, float speed) const {
+        PhysicsEvent event = {};
+        event.step = step;
+        event.type = type;
+        event.a = static_cast<std::int16_t>(a);
+        event.b = static_cast<std::int16_t>(b);
+        event.x = x;
+        event.y = y;
+        event.speed = speed;
+        stream->publish(event);
+    }
+};
@@ -2,6 +2,9 @@
 #include "RoundedRectangleShape.cpp"
 #include "Constants.hpp"
 #include "Ball.cpp"
+#include "TableGeometry.cpp"
+#include "TableConfig.cpp"
+#include "AssetCache.cpp"
 
 class PoolTable {
 private:
@@ -10,54 +13,49 @@ private:
     sf::RectangleShape cushionShape;
     std::vector<sf::CircleShape> pockets;
     float pocketRadius;
+    const TableGeometry& geometry;
 
-    sf::Texture borderTexture;
-    sf::Texture cushionTexture;
-    sf::Texture tableTexture;
+    // Border dan cushion memakai tekstur yang sama dari cache
+    std::shared_ptr<sf::Texture> borderTexture;
+    std::shared_ptr<sf::Texture> tableTexture;
 
+    // Posisi lubang diambil dari geometri yang juga dipakai fisika
     void setupPockets() {
-        std::vector<sf::Vector2f> pocketPositions = {
-            {TableBorder - pocketRadius, TableBorder - pocketRadius},            
-            {(WindowWidth / 2) - pocketRadius, TableBorder - pocketRadius}, 
-            {WindowWidth - TableBorder - pocketRadius, TableBorder - pocketRadius}, 
-            {TableBorder - pocketRadius, WindowHeight - TableBorder - pocketRadius}, 
-            {(WindowWidth / 2) - pocketRadius, WindowHeight - TableBorder - pocketRadius},
-            {WindowWidth - TableBorder - pocketRadius, WindowHeight - TableBorder - pocketRadius} 
-        };
-        for (const auto& position : pocketPositions) {
+        for (const auto& p : geometry.getPockets()) {
             sf::CircleShape pocket(pocketRadius);
             pocket.setFillColor(sf::Color::Black);
-            pocket.setPosition(position + sf::Vector2f(OFFSET_X, OFFSET_Y)); // Apply offset
+            pocket.setPosition(p.cx - pocketRadius + OFFSET_X, p.cy - pocketRadius + OFFSET_Y); // Apply offset
             pockets.push_back(pocket);
         }
     }
 
 public:
-    PoolTable() : pocketRadius(25.0f) {
-        if (!borderTexture.loadFromFile("D:/sfmll/bg/border_texture.jpg")) {
-        }
-        if (!cushionTexture.loadFromFile("D:/sfmll/bg/border_texture.jpg")) {
-        }
-        if (!tableTexture.loadFromFile("D:/sfmll/bg/green_texture.jpg")) {
-        }
+    // Meja bawaan (ClassicTable)
+    explicit PoolTable(AssetCache& assets) : PoolTable(assets, TableProfile::from(ClassicTable()), defaultTableGeometry()) {}
 
-        tableShape.setSize(sf::Vector2f(TableWidth, TableHeight));
-        tableShape.setTexture(&tableTexture); 
-        tableShape.setPosition(TableBorder + OFFSET_X, TableBorder + OFFSET_Y); 
+    // tableGeometry harus dibuat dari profile yang sama dan hidup lebih lama dari meja ini.
+    PoolTable(AssetCache& assets, const TableProfile& profile, const TableGeometry& tableGeometry)
+        : pocketRadius(profile.pocketRadius), geometry(tableGeometry) {
+        borderTexture = assets.texture("bg/border_texture.jpg");
+        tableTexture = assets.texture("bg/green_texture.jpg");
 
-        borderShape.setSize(sf::Vector2f(WindowWidth, WindowHeight));
-        borderShape.setTexture(&borderTexture); 
+        tableShape.setSize(sf::Vector2f(profile.width, profile.height));
+        tableShape.setTexture(tableTexture.get()); 
+        tableShape.setPosition(profile.left() + OFFSET_X, profile.top() + OFFSET_Y); 
+
+        borderShape.setSize(sf::Vector2f(profile.width + profile.border * 2, profile.height + profile.border * 2));
+        borderShape.setTexture(borderTexture.get()); 
         borderShape.setPosition(OFFSET_X, OFFSET_Y); 
         borderShape.setCornersRadius(20.0f); 
 
-        cushionShape.setSize(sf::Vector2f(TableWidth + 20, TableHeight + 20));
-        cushionShape.setTexture(&cushionTexture); 
-        cushionShape.setPosition(TableBorder - 10 + OFFSET_X, TableBorder - 10 + OFFSET_Y);
+        cushionShape.setSize(sf::Vector2f(profile.width + 20, profile.height + 20));
+        cushionShape.setTexture(borderTexture.get()); 
+        cushionShape.setPosition(profile.left() - 10 + OFFSET_X, profile.top() - 10 + OFFSET_Y);
 
         setupPockets();
     }
 
-    void draw(sf::RenderWindow& window) const {
+    void draw(sf::RenderTarget& window) const {
         window.draw(borderShape);
         window.draw(cushionShape);
         window.draw(tableShape);
@@ -67,12 +65,7 @@ public:
     }
 
     bool isPocketed(Ball& ball) {
-        for (const auto& pocket : pockets) {
-            sf::FloatRect pocketBounds = pocket.getGlobalBounds();
-            if (pocketBounds.contains(ball.getPosition())) {
-                return true;
-            }
-        }
-        return false;
+        sf::Vector2f position = ball.getPosition();
+        return geometry.findPocket(position.x - OFFSET_X, position.y - OFFSET_Y) >= 0;
     }
 };
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+// Tipe angka untuk fisika. BasicTableState, integrator, dan respons tumbukan
+// adalah template atas tipe ini, jadi presisi dipilih saat kompilasi tanpa
+// biaya dispatch:
+//   float    cepat, untuk permainan interaktif (TableState)
+//   double   lebih presisi untuk analisis dan rollout panjang
+//   Fixed32  bit-exact di semua compiler dan CPU, untuk lockstep lintas platform
+//
+// Kode generik menulis konstanta sebagai Real(x), membandingkan dengan
+// operator biasa, dan memakai squareRoot() serta static_cast<float>/<double>.
+
+// Fixed-point 32-bit Q16.16 (rentang +-32767, resolusi 1/65536). Semua operasi
+// hanya memakai aritmetika integer dan jenuh (saturating) saat meluap, sehingga
+// kuadrat jarak bola yang berjauhan tetap besar, bukan membungkus ke negatif.
+class Fixed32 {
+private:
+    std::int32_t raw;
+
+    static std::int32_t saturate(std::int64_t value) {
+        if (value > std::numeric_limits<std::int32_t>::max()) return std::numeric_limits<std::int32_t>::max();
+        if (value < std::numeric_limits<std::int32_t>::min()) return std::numeric_limits<std::int32_t>::min();
+        return static_cast<std::int32_t>(value);
+    }
+
+public:
+    static const int FractionBits = 16;
+    static const std::int64_t One = std::int64_t(1) << FractionBits;
+
+    Fixed32() : raw(0) {}
+    explicit Fixed32(int value) : raw(saturate(static_cast<std::int64_t>(value) * One)) {}
+    explicit Fixed32(double value) : raw(saturate(std::llround(value * One))) {}
+    explicit Fixed32(float value) : Fixed32(static_cast<double>(value)) {}
+
+    static Fixed32 fromRaw(std::int32_t value) {
+        Fixed32 result;
+        result.raw = value;
+        return result;
+    }
+
+    std::int32_t getRaw() const {
+        return raw;
+    }
+
+    explicit operator double() const {
+        return static_cast<double>(raw) / One;
+    }
+
+    explicit operator float() const {
+        return static_cast<float>(static_cast<double>(raw) / One);
+    }
+
+    Fixed32 operator-() const {
+        return fromRaw(saturate(-static_cast<std::int64_t>(raw)));
+    }
+
+    friend Fixed32 operator+(Fixed32 a, Fixed32 b) {
+        return fromRaw(saturate(static_cast<std::int64_t>(a.raw) + b.raw));
+    }
+
+    friend Fixed32 operator-(Fixed32 a, Fixed32 b) {
+        return fromRaw(saturate(static_cast<std::int64_t>(a.raw) - b.raw));
+    }
+
+    // Dibulatkan ke nilai terdekat (setengah ke atas).
+    friend Fixed32 operator*(Fixed32 a, Fixed32 b) {
+        std::int64_t product = static_cast<std::int64_t>(a.raw) * b.raw;
+        return fromRaw(saturate((product + (One >> 1)) >> FractionBits));
+    }
+
+    // Pembagian dengan nol jenuh ke batas sesuai tanda pembilang.
+    friend Fixed32 operator/(Fixed32 a, Fixed32 b) {
+        if (b.raw == 0) {
+            return fromRaw(a.raw >= 0 ? std::numeric_limits<std::int32_t>::max() : std::numeric_limits<std::int32_t>::min());
+        }
+        return fromRaw(saturate(static_cast<std::int64_t>(a.raw) * One / b.raw));
+    }
+
+    Fixed32& operator+=(Fixed32 other) { return *this = *this + other; }
+    Fixed32& operator-=(Fixed32 other) { return *this = *this - other; }
+    Fixed32& operator*=(Fixed32 other) { return *this = *this * other; }
+    Fixed32& operator/=(Fixed32 other) { return *this = *this / other; }
+
+    friend bool operator==(Fixed32 a, Fixed32 b) { return a.raw == b.raw; }
+    friend bool operator!=(Fixed32 a, Fixed32 b) { return a.raw != b.raw; }
+    friend bool operator<(Fixed32 a, Fixed32 b) { return a.raw < b.raw; }
+    friend bool operator<=(Fixed32 a, Fixed32 b) { return a.raw <= b.raw; }
+    friend bool operator>(Fixed32 a, Fixed32 b) { return a.raw > b.raw; }
+    friend bool operator>=(Fixed32 a, Fixed32 b) { return a.raw >= b.raw; }
+};
+
+inline float squareRoot(float value) {
+    return std::sqrt(value);
+}
+
+inline double squareRoot(double value) {
+    return std::sqrt(value);
+}
+
+// Akar integer (dibulatkan ke bawah) dari raw << 16; nilai negatif menjadi 0.
+inline Fixed32 squareRoot(Fixed32 value) {
+    if (value.getRaw() <= 0) return Fixed32();
+
+    std::uint64_t remainder = static_cast<std::uint64_t>(value.getRaw()) << Fixed32::FractionBits;
+    std::uint64_t root = 0;
+    std::uint64_t bit = std::uint64_t(1) << 62;
+    while (bit > remainder) bit >>= 2;
+    while (bit != 0) {
+        if (remainder >= root + bit) {
+            remainder -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return Fixed32::fromRaw(static_cast<std::int32_t>(root));
+}
+
+template <typename Real>
+inline const char* precisionName();
+
+template <>
+inline const char* precisionName<float>() {
+    return "float";
+}
+
+template <>
+inline const char* precisionName<double>() {
+    return "double";
+}
+
+template <>
+inline const char* precisionName<Fixed32>() {
+    return "fixed32";
+}
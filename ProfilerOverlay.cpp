@@ -0,0 +1,65 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstdio>
+#include <string>
+#include "FrameProfiler.cpp"
+
+// Tabel waktu per fase (ms) di bawah power bar Stick. Teks hanya disusun
+// ulang beberapa kali per detik supaya overlay sendiri tidak membebani frame.
+class ProfilerOverlay : public sf::Drawable {
+private:
+    sf::RectangleShape background;
+    sf::Text text;
+    bool visible;
+    int framesUntilRefresh;
+
+    static const int RefreshInterval = 15;
+
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override {
+        if (!visible) return;
+        target.draw(background, states);
+        target.draw(text, states);
+    }
+
+public:
+    explicit ProfilerOverlay(const sf::Font& font) : visible(false), framesUntilRefresh(0) {
+        background.setPosition(10.0f, 40.0f);
+        background.setFillColor(sf::Color(0, 0, 0, 170));
+
+        text.setFont(font);
+        text.setCharacterSize(12);
+        text.setFillColor(sf::Color::White);
+        text.setPosition(16.0f, 44.0f);
+    }
+
+    void toggle() {
+        visible = !visible;
+        framesUntilRefresh = 0;
+    }
+
+    bool isVisible() const {
+        return visible;
+    }
+
+    void update(const FrameProfiler& profiler) {
+        if (!visible || --framesUntilRefresh > 0) return;
+        framesUntilRefresh = RefreshInterval;
+
+        std::string content = "fase        min    p50    p99    max (ms)\n";
+        char line[96];
+        for (int phase = 0; phase < PhaseCount; ++phase) {
+            FrameProfiler::Stats s = profiler.stats(phase);
+            std::snprintf(line, sizeof(line), "%-10s %6.2f %6.2f %6.2f %6.2f\n",
+                          profilePhaseName(phase), s.min, s.p50, s.p99, s.max);
+            content += line;
+        }
+        if (profiler.isTracing()) {
+            content += "merekam trace...";
+        }
+        text.setString(content);
+
+        sf::FloatRect bounds = text.getLocalBounds();
+        background.setSize(sf::Vector2f(bounds.width + 16.0f, bounds.height + 16.0f));
+    }
+};
@@ -0,0 +1,517 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Constants.hpp"
+#include "TableState.cpp"
+#include "Shot.cpp"
+#include "TableConfig.cpp"
+#include "TableGeometry.cpp"
+#include "FixedStepClock.cpp"
+#include "EventEngine.cpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define BILLIARD_MMAP 1
+#endif
+
+// Format replay biner (little-endian, semua offset absolut dari awal file):
+//
+//   header   32 byte   "BRPL", u16 versi, u16 jumlah bola, u32 interval keyframe,
+//                      u32 jumlah pukulan, u64 offset indeks, f32 step rate, u32 substep
+//   meja     96 byte   profil meja: 15 * f32 (width, height, border, ballRadius, pocketRadius,
+//                      cornerMouth, sideMouth, jawRadius, captureRadius, cueX, cueY, rackX,
+//                      rackY, rackColumnSpacing, rackRowSpacing), u8 gaya rak, u8 panjang
+//                      nama, 2 byte nol, 32 byte nama
+//   rak      n * 8     posisi awal setiap bola (f32 x, f32 y)
+//   pukulan  berurutan u32 langkah fisika, f32 sudut, f32 power, f32 x/y bola putih,
+//                      u8 mode simulasi (ReplayShotMode), u8 ada keyframe, lalu keyframe opsional:
+//                      i32 first contact, n * (f32 x, y, vx, vy, u8 flags)
+//   indeks   m * 20    u64 offset pukulan, u64 offset keyframe terdekat, u32 nomor pukulannya
+//
+// Keyframe menyimpan meja tepat setelah impuls cue diberikan, setiap interval pukulan
+// dan pada pukulan pertama setelah meja diganti dari luar (rewind, snapshot). Untuk lompat ke
+// pukulan ke-n cukup baca satu entri indeks, pulihkan keyframe, lalu simulasikan
+// paling banyak interval-1 pukulan, berapa pun panjang pertandingannya.
+//
+// Langkah fisika adalah hitungan FixedStepClock saat pukulan diberikan, juga
+// untuk pukulan event-driven (jam tidak berjalan di mode itu). Pukulan fixed-step
+// disimulasikan ulang sebanyak selisih langkah ke pukulan berikutnya; pukulan
+// event-driven dijalankan sampai diam dengan EventEngine.
+enum ReplayShotMode : std::uint8_t {
+    ReplayFixedStep,
+    ReplayEventDriven
+};
+
+namespace replay {
+
+const char Magic[4] = { 'B', 'R', 'P', 'L' };
+const std::uint16_t Version = 3;
+const std::size_t ProfileOffset = 32;
+const std::size_t ProfileNameSize = 32;
+const std::size_t HeaderSize = ProfileOffset + 96;
+const std::size_t IndexEntrySize = 20;
+const std::size_t ShotSize = 22;
+const std::size_t KeyframeBallSize = 17;
+const int MaxSubsteps = 64; // batas wajar; nilai rusak bisa membuat seek() nyaris tak selesai
+
+inline void putU8(std::vector<std::uint8_t>& out, std::uint8_t value) {
+    out.push_back(value);
+}
+
+inline void putU16(std::vector<std::uint8_t>& out, std::uint16_t value) {
+    out.push_back(static_cast<std::uint8_t>(value));
+    out.push_back(static_cast<std::uint8_t>(value >> 8));
+}
+
+inline void putU32(std::vector<std::uint8_t>& out, std::uint32_t value) {
+    for (int k = 0; k < 4; ++k) out.push_back(static_cast<std::uint8_t>(value >> (8 * k)));
+}
+
+inline void putU64(std::vector<std::uint8_t>& out, std::uint64_t value) {
+    for (int k = 0; k < 8; ++k) out.push_back(static_cast<std::uint8_t>(value >> (8 * k)));
+}
+
+inline void putF32(std::vector<std::uint8_t>& out, float value) {
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    putU32(out, bits);
+}
+
+inline std::uint16_t getU16(const std::uint8_t* p) {
+    return static_cast<std::uint16_t>(p[0] | (p[1] << 8));
+}
+
+inline std::uint32_t getU32(const std::uint8_t* p) {
+    return static_cast<std::uint32_t>(p[0]) | (static_cast<std::uint32_t>(p[1]) << 8) |
+           (static_cast<std::uint32_t>(p[2]) << 16) | (static_cast<std::uint32_t>(p[3]) << 24);
+}
+
+inline std::uint64_t getU64(const std::uint8_t* p) {
+    return static_cast<std::uint64_t>(getU32(p)) | (static_cast<std::uint64_t>(getU32(p + 4)) << 32);
+}
+
+inline float getF32(const std::uint8_t* p) {
+    std::uint32_t bits = getU32(p);
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// Anggota profil yang disimpan sebagai f32, urut seperti di header.
+template <typename Profile>
+auto profileFloat(Profile& profile, int k) -> decltype(&profile.width) {
+    decltype(&profile.width) fields[15] = {
+        &profile.width, &profile.height, &profile.border, &profile.ballRadius, &profile.pocketRadius,
+        &profile.cornerMouth, &profile.sideMouth, &profile.jawRadius, &profile.captureRadius,
+        &profile.cueX, &profile.cueY, &profile.rackX, &profile.rackY,
+        &profile.rackColumnSpacing, &profile.rackRowSpacing
+    };
+    return fields[k];
+}
+
+inline void putProfile(std::vector<std::uint8_t>& out, const TableProfile& profile) {
+    for (int k = 0; k < 15; ++k) putF32(out, *profileFloat(profile, k));
+    const std::size_t nameLength = std::min(profile.name.size(), ProfileNameSize);
+    putU8(out, static_cast<std::uint8_t>(profile.rackStyle));
+    putU8(out, static_cast<std::uint8_t>(nameLength));
+    putU16(out, 0);
+    for (std::size_t k = 0; k < ProfileNameSize; ++k) {
+        putU8(out, k < nameLength ? static_cast<std::uint8_t>(profile.name[k]) : 0);
+    }
+}
+
+// false bila ukuran meja bukan angka, tidak positif (lihat loadTableProfile), atau
+// terlalu besar untuk grid broadphase (lebih dari sejuta sel).
+inline bool getProfile(const std::uint8_t* p, int ballCount, TableProfile& profile) {
+    for (int k = 0; k < 15; ++k) *profileFloat(profile, k) = getF32(p + 4 * k);
+    profile.rackStyle = (p[60] == RackSnooker) ? RackSnooker : RackEightBall;
+    profile.name.assign(reinterpret_cast<const char*>(p + 64), std::min<std::size_t>(p[61], ProfileNameSize));
+    profile.ballCount = ballCount;
+
+    for (int k = 0; k < 15; ++k) {
+        if (!std::isfinite(*profileFloat(profile, k))) return false;
+    }
+    if (!(profile.width > 0 && profile.height > 0 && profile.ballRadius > 0 && profile.captureRadius > 0 &&
+          profile.cornerMouth > 0 && profile.sideMouth > 0 && profile.jawRadius > 0)) {
+        return false;
+    }
+    const float cell = 2 * profile.ballRadius;
+    return (profile.width / cell + 1) * (profile.height / cell + 1) <= 1e6f;
+}
+
+} // namespace replay
+
+// Merekam rak awal, setiap pukulan cue, dan keyframe berkala ke file.
+// Data pukulan ditulis langsung (streaming); indeks ditulis saat finish().
+class ReplayRecorder {
+private:
+    std::ofstream file;
+    std::vector<std::uint8_t> buffer;
+    std::vector<std::uint8_t> index;
+    std::uint64_t offset;
+    std::uint64_t keyframeOffset;
+    std::uint32_t keyframeShot;
+    std::uint32_t shotCount;
+    std::uint32_t keyframeInterval;
+    std::uint16_t ballCount;
+    bool keyframePending;
+
+    void flush() {
+        file.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+        offset += buffer.size();
+        buffer.clear();
+    }
+
+    void writeHeader(const TableProfile& profile, float stepRate, int substeps) {
+        buffer.insert(buffer.end(), replay::Magic, replay::Magic + 4);
+        replay::putU16(buffer, replay::Version);
+        replay::putU16(buffer, ballCount);
+        replay::putU32(buffer, keyframeInterval);
+        replay::putU32(buffer, shotCount);
+        replay::putU64(buffer, 0); // diisi saat finish()
+        replay::putF32(buffer, stepRate);
+        replay::putU32(buffer, static_cast<std::uint32_t>(substeps));
+        replay::putProfile(buffer, profile);
+    }
+
+public:
+    explicit ReplayRecorder(std::uint32_t keyframeEvery = 8)
+        : offset(0), keyframeOffset(0), keyframeShot(0), shotCount(0),
+          keyframeInterval(keyframeEvery > 0 ? keyframeEvery : 1), ballCount(0), keyframePending(false) {}
+
+    ~ReplayRecorder() {
+        finish();
+    }
+
+    // Mulai rekaman baru; state harus berisi rak awal sebelum pukulan pertama, di meja profile.
+    bool begin(const std::string& path, const TableState& state,
+               const TableProfile& profile = TableProfile::from(ClassicTable()),
+               float stepRate = PhysicsStepRate, int substeps = PhysicsSubsteps) {
+        finish();
+        file.open(path, std::ios::binary | std::ios::trunc);
+        if (!file) return false;
+
+        offset = 0;
+        shotCount = 0;
+        keyframePending = false;
+        index.clear();
+        ballCount = static_cast<std::uint16_t>(state.size());
+
+        writeHeader(profile, stepRate, substeps);
+        for (int i = 0; i < ballCount; ++i) {
+            replay::putF32(buffer, state.posX[i]);
+            replay::putF32(buffer, state.posY[i]);
+        }
+        flush();
+        return true;
+    }
+
+    bool isRecording() const {
+        return file.is_open();
+    }
+
+    // Meja diganti tanpa pukulan (misalnya rewind): pukulan berikutnya wajib membawa
+    // keyframe, karena pukulan sebelumnya tidak lagi mengarah ke meja ini.
+    void requestKeyframe() {
+        keyframePending = true;
+    }
+
+    // Catat satu pukulan; dipanggil tepat setelah impuls cue diberikan ke state.
+    // physicsStep adalah hitungan FixedStepClock, apa pun mode simulasinya.
+    void recordShot(const TableState& state, std::uint64_t physicsStep, const Shot& shot,
+                    ReplayShotMode mode = ReplayFixedStep) {
+        if (!file.is_open()) return;
+
+        bool keyframe = keyframePending || (shotCount % keyframeInterval) == 0;
+        keyframePending = false;
+        if (keyframe) {
+            keyframeOffset = offset;
+            keyframeShot = shotCount;
+        }
+        replay::putU64(index, offset);
+        replay::putU64(index, keyframeOffset);
+        replay::putU32(index, keyframeShot);
+
+        replay::putU32(buffer, static_cast<std::uint32_t>(physicsStep));
+        replay::putF32(buffer, shot.angle);
+        replay::putF32(buffer, shot.power);
+        replay::putF32(buffer, state.posX[CueBallIndex]);
+        replay::putF32(buffer, state.posY[CueBallIndex]);
+        replay::putU8(buffer, mode);
+        replay::putU8(buffer, keyframe ? 1 : 0);
+
+        if (keyframe) {
+            replay::putU32(buffer, static_cast<std::uint32_t>(state.firstContact));
+            for (int i = 0; i < ballCount; ++i) {
+                replay::putF32(buffer, state.posX[i]);
+                replay::putF32(buffer, state.posY[i]);
+                replay::putF32(buffer, state.velX[i]);
+                replay::putF32(buffer, state.velY[i]);
+                replay::putU8(buffer, state.flags[i]);
+            }
+        }
+        ++shotCount;
+        flush();
+    }
+
+    // Tulis indeks dan lengkapi header. Aman dipanggil berkali-kali.
+    void finish() {
+        if (!file.is_open()) return;
+
+        std::uint64_t indexOffset = offset;
+        file.write(reinterpret_cast<const char*>(index.data()), static_cast<std::streamsize>(index.size()));
+
+        std::vector<std::uint8_t> patch;
+        replay::putU32(patch, shotCount);
+        replay::putU64(patch, indexOffset);
+        file.seekp(12);
+        file.write(reinterpret_cast<const char*>(patch.data()), static_cast<std::streamsize>(patch.size()));
+        file.close();
+    }
+
+    std::uint32_t getShotCount() const {
+        return shotCount;
+    }
+};
+
+// Membaca replay dari memori. Data bisa berasal dari mmap (open()) atau dari
+// buffer milik pemanggil (attach()); tidak ada yang disalin saat membuka file.
+class ReplayReader {
+private:
+    const std::uint8_t* data;
+    std::size_t size;
+    std::vector<std::uint8_t> storage;
+#if defined(BILLIARD_MMAP)
+    void* mapping;
+#endif
+
+    std::uint16_t ballCount;
+    std::uint32_t keyframeInterval;
+    std::uint32_t shotCount;
+    std::uint64_t indexOffset;
+    float stepRate;
+    int substeps;
+    TableProfile profile;
+    TableGeometry geometry;
+
+    const std::uint8_t* indexEntry(std::uint32_t shot) const {
+        return data + indexOffset + static_cast<std::uint64_t>(shot) * replay::IndexEntrySize;
+    }
+
+    const std::uint8_t* shotRecord(std::uint32_t shot) const {
+        return data + replay::getU64(indexEntry(shot));
+    }
+
+    // Rekaman sepanjang need byte di offset harus berada di antara rak dan indeks.
+    bool inShotArea(std::uint64_t offset, std::uint64_t need) const {
+        std::uint64_t rackEnd = replay::HeaderSize + static_cast<std::uint64_t>(ballCount) * 8;
+        return offset >= rackEnd && offset <= indexOffset && indexOffset - offset >= need;
+    }
+
+    // Periksa setiap entri indeks supaya seek() dan getShot() tidak membaca di luar data.
+    bool validIndex() const {
+        const std::uint64_t keyframeSize = replay::ShotSize + 4 + static_cast<std::uint64_t>(ballCount) * replay::KeyframeBallSize;
+        for (std::uint32_t shot = 0; shot < shotCount; ++shot) {
+            const std::uint8_t* entry = indexEntry(shot);
+            std::uint64_t shotOffset = replay::getU64(entry);
+            std::uint64_t keyframeOffset = replay::getU64(entry + 8);
+            std::uint32_t keyframeShot = replay::getU32(entry + 16);
+
+            if (!inShotArea(shotOffset, replay::ShotSize) || !inShotArea(keyframeOffset, keyframeSize)) return false;
+            if (keyframeShot > shot || keyframeOffset > shotOffset) return false;
+            if (data[shotOffset + 20] > ReplayEventDriven || data[keyframeOffset + 21] != 1) return false;
+        }
+        return true;
+    }
+
+    // Bola putih yang masuk lubang dikembalikan ke posisi yang tercatat, seperti Ball::respawn().
+    void placeCueBall(TableState& state, const std::uint8_t* record) const {
+        if (!state.isPocketed(CueBallIndex)) return;
+        state.posX[CueBallIndex] = state.prevX[CueBallIndex] = replay::getF32(record + 12);
+        state.posY[CueBallIndex] = state.prevY[CueBallIndex] = replay::getF32(record + 16);
+        state.velX[CueBallIndex] = 0.0f;
+        state.velY[CueBallIndex] = 0.0f;
+        state.setFlag(CueBallIndex, BallPocketed, false);
+    }
+
+    void unmap() {
+#if defined(BILLIARD_MMAP)
+        if (mapping) {
+            munmap(mapping, size);
+            mapping = nullptr;
+        }
+#endif
+        storage.clear();
+        data = nullptr;
+        size = 0;
+    }
+
+public:
+    ReplayReader()
+        : data(nullptr), size(0),
+#if defined(BILLIARD_MMAP)
+          mapping(nullptr),
+#endif
+          ballCount(0), keyframeInterval(1), shotCount(0), indexOffset(0), stepRate(PhysicsStepRate), substeps(PhysicsSubsteps),
+          profile(TableProfile::from(ClassicTable())), geometry(defaultTableGeometry()) {}
+
+    ~ReplayReader() {
+        unmap();
+    }
+
+    ReplayReader(const ReplayReader&) = delete;
+    ReplayReader& operator=(const ReplayReader&) = delete;
+
+    // Petakan file ke memori (atau baca seluruhnya bila mmap tidak tersedia).
+    bool open(const std::string& path) {
+        unmap();
+#if defined(BILLIARD_MMAP)
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size == 0) {
+            ::close(fd);
+            return false;
+        }
+        void* mapped = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (mapped == MAP_FAILED) return false;
+        mapping = mapped;
+        return attach(static_cast<const std::uint8_t*>(mapped), static_cast<std::size_t>(info.st_size));
+#else
+        std::ifstream file(path, std::ios::binary);
+        if (!file) return false;
+        storage.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        return attach(storage.data(), storage.size());
+#endif
+    }
+
+    // Pakai buffer yang sudah ada di memori; buffer harus hidup selama reader dipakai.
+    // Mengembalikan false (tanpa pukulan) bila header atau indeks rusak atau terpotong.
+    bool attach(const std::uint8_t* bytes, std::size_t length) {
+        data = bytes;
+        size = length;
+        shotCount = 0;
+        if (size < replay::HeaderSize || std::memcmp(data, replay::Magic, 4) != 0) return false;
+        if (replay::getU16(data + 4) != replay::Version) return false;
+
+        ballCount = replay::getU16(data + 6);
+        keyframeInterval = replay::getU32(data + 8);
+        std::uint32_t count = replay::getU32(data + 12);
+        indexOffset = replay::getU64(data + 16);
+        stepRate = replay::getF32(data + 24);
+        std::uint32_t substepCount = replay::getU32(data + 28);
+        if (!std::isfinite(stepRate) || stepRate <= 0 || substepCount == 0 ||
+            substepCount > static_cast<std::uint32_t>(replay::MaxSubsteps)) {
+            return false;
+        }
+        substeps = static_cast<int>(substepCount);
+        if (!replay::getProfile(data + replay::ProfileOffset, ballCount, profile)) return false;
+        geometry = TableGeometry(profile);
+
+        std::uint64_t rackEnd = replay::HeaderSize + static_cast<std::uint64_t>(ballCount) * 8;
+        if (rackEnd > indexOffset || indexOffset > size ||
+            (size - indexOffset) / replay::IndexEntrySize < count) {
+            return false;
+        }
+        shotCount = count;
+        if (!validIndex()) {
+            shotCount = 0;
+            return false;
+        }
+        return true;
+    }
+
+    // Rak awal sebelum pukulan pertama.
+    void loadRack(TableState& state) const {
+        state = TableState();
+        for (int i = 0; i < ballCount; ++i) {
+            const std::uint8_t* p = data + replay::HeaderSize + i * 8;
+            state.addBall(replay::getF32(p), replay::getF32(p + 4));
+        }
+    }
+
+    Shot getShot(std::uint32_t shot) const {
+        const std::uint8_t* record = shotRecord(shot);
+        return Shot{ replay::getF32(record + 4), replay::getF32(record + 8) };
+    }
+
+    std::uint32_t getPhysicsStep(std::uint32_t shot) const {
+        return replay::getU32(shotRecord(shot));
+    }
+
+    ReplayShotMode getShotMode(std::uint32_t shot) const {
+        return static_cast<ReplayShotMode>(shotRecord(shot)[20]);
+    }
+
+    // Meja tempat replay direkam.
+    const TableProfile& getProfile() const {
+        return profile;
+    }
+
+    // Isi state dengan meja tepat setelah pukulan ke-shot: pulihkan keyframe terdekat
+    // dari indeks, lalu simulasikan ulang pukulan di antaranya dengan FixedStepClock
+    // (atau EventEngine untuk pukulan yang direkam dalam mode event-driven) di meja rekaman.
+    bool seek(std::uint32_t shot, TableState& state) const {
+        if (shot >= shotCount) return false;
+
+        const std::uint8_t* entry = indexEntry(shot);
+        std::uint32_t first = replay::getU32(entry + 16);
+        const std::uint8_t* keyframe = data + replay::getU64(entry + 8) + replay::ShotSize;
+
+        loadRack(state);
+        state.firstContact = static_cast<int>(replay::getU32(keyframe));
+        for (int i = 0; i < ballCount; ++i) {
+            const std::uint8_t* p = keyframe + 4 + i * replay::KeyframeBallSize;
+            state.posX[i] = state.prevX[i] = replay::getF32(p);
+            state.posY[i] = state.prevY[i] = replay::getF32(p + 4);
+            state.velX[i] = replay::getF32(p + 8);
+            state.velY[i] = replay::getF32(p + 12);
+            state.flags[i] = p[16];
+        }
+
+        BasicFixedStepClock<float, TableProfile> clock(state, profile, geometry, stepRate, substeps);
+        std::unique_ptr<EventEngine> engine; // dibuat hanya bila ada pukulan event-driven
+        for (std::uint32_t k = first; k < shot; ++k) {
+            if (getShotMode(k) == ReplayEventDriven) {
+                if (engine) {
+                    engine->reset();
+                } else {
+                    engine.reset(new EventEngine(state, geometry, profile.ballRadius));
+                }
+                engine->runToRest();
+            } else {
+                std::uint32_t from = getPhysicsStep(k);
+                std::uint32_t to = getPhysicsStep(k + 1);
+                for (std::uint32_t s = from; s < to; ++s) clock.tick();
+            }
+
+            const std::uint8_t* next = shotRecord(k + 1);
+            placeCueBall(state, next);
+            applyShot(state, Shot{ replay::getF32(next + 4), replay::getF32(next + 8) });
+        }
+        return true;
+    }
+
+    int getBallCount() const {
+        return ballCount;
+    }
+
+    std::uint32_t getShotCount() const {
+        return shotCount;
+    }
+
+    std::uint32_t getKeyframeInterval() const {
+        return keyframeInterval;
+    }
+};
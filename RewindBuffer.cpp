@@ -0,0 +1,293 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <utility>
+#include <vector>
+#include "TableState.cpp"
+
+// Ring buffer snapshot meja untuk rewind. Memori dialokasikan sekali (capacity
+// byte untuk data + slot deskriptor tetap). Setiap entri berupa keyframe penuh
+// atau delta terhadap keyframe terakhir yang hanya berisi bola yang berubah;
+// frame yang identik dengan frame sebelumnya (semua bola diam) hanya
+// memperpanjang entri terakhir, jadi bola yang diam tidak memakan tempat.
+// Entri tertua dibuang saat tempat habis.
+class RewindBuffer {
+private:
+    struct Entry {
+        std::size_t offset;
+        std::size_t size;
+        std::uint64_t keyframe;  // nomor entri keyframe acuan (diri sendiri untuk keyframe)
+        double startTime;
+        double endTime;
+    };
+
+    // Satu bola dalam snapshot: indeks, posisi, kecepatan, flag
+    static const std::size_t BallSize = sizeof(std::uint16_t) + 4 * sizeof(float) + sizeof(std::uint8_t);
+    static const std::size_t EntryHeaderSize = sizeof(std::int32_t) + sizeof(std::uint16_t);
+
+    std::vector<std::uint8_t> data;
+    std::vector<Entry> entries;
+    std::uint64_t first;   // nomor entri tertua
+    std::uint64_t next;    // nomor entri berikutnya
+    int keyframeInterval;
+
+    TableState keyframeState;
+    TableState lastState;
+    std::uint64_t keyframeEntry;
+    std::vector<int> changed;
+
+    Entry& entry(std::uint64_t number) {
+        return entries[number % entries.size()];
+    }
+
+    const Entry& entry(std::uint64_t number) const {
+        return entries[number % entries.size()];
+    }
+
+    std::size_t count() const {
+        return static_cast<std::size_t>(next - first);
+    }
+
+    static bool sameBall(const TableState& a, const TableState& b, int i) {
+        return a.posX[i] == b.posX[i] && a.posY[i] == b.posY[i] && a.velX[i] == b.velX[i] &&
+               a.velY[i] == b.velY[i] && a.flags[i] == b.flags[i];
+    }
+
+    static bool sameTable(const TableState& a, const TableState& b) {
+        if (a.size() != b.size() || a.firstContact != b.firstContact) return false;
+        for (int i = 0; i < static_cast<int>(a.size()); ++i) {
+            if (!sameBall(a, b, i)) return false;
+        }
+        return true;
+    }
+
+    void evictOldest() {
+        ++first;
+        // Delta tidak berguna tanpa keyframe-nya
+        while (first < next && entry(first).keyframe < first) {
+            ++first;
+        }
+    }
+
+    // Cari tempat berurutan sebesar size byte, buang entri tertua bila perlu.
+    std::size_t allocate(std::size_t size) {
+        while (true) {
+            if (count() == 0) return 0;
+
+            const Entry& oldest = entry(first);
+            const Entry& newest = entry(next - 1);
+            std::size_t end = newest.offset + newest.size;
+            if (newest.offset >= oldest.offset) {
+                if (data.size() - end >= size) return end;
+                if (oldest.offset >= size) return 0;
+            } else if (oldest.offset - end >= size) {
+                return end;
+            }
+            evictOldest();
+        }
+    }
+
+    template <typename T>
+    static void put(std::uint8_t*& p, T value) {
+        std::memcpy(p, &value, sizeof(T));
+        p += sizeof(T);
+    }
+
+    template <typename T>
+    static T get(const std::uint8_t*& p) {
+        T value;
+        std::memcpy(&value, p, sizeof(T));
+        p += sizeof(T);
+        return value;
+    }
+
+    static void putBall(std::uint8_t*& p, const TableState& state, int i) {
+        put<std::uint16_t>(p, static_cast<std::uint16_t>(i));
+        put<float>(p, state.posX[i]);
+        put<float>(p, state.posY[i]);
+        put<float>(p, state.velX[i]);
+        put<float>(p, state.velY[i]);
+        put<std::uint8_t>(p, state.flags[i]);
+    }
+
+    // Terapkan isi satu entri (keyframe atau delta) ke state.
+    static void decode(const std::uint8_t* p, TableState& state) {
+        state.firstContact = get<std::int32_t>(p);
+        std::uint16_t balls = get<std::uint16_t>(p);
+        for (int k = 0; k < balls; ++k) {
+            int i = get<std::uint16_t>(p);
+            state.posX[i] = get<float>(p);
+            state.posY[i] = get<float>(p);
+            state.velX[i] = get<float>(p);
+            state.velY[i] = get<float>(p);
+            state.flags[i] = get<std::uint8_t>(p);
+        }
+    }
+
+    // Tulis bola di changed sebagai entri baru.
+    void write(const TableState& state, double time, bool keyframe) {
+        std::size_t size = EntryHeaderSize + changed.size() * BallSize;
+        if (size > data.size()) return;
+        if (count() == entries.size()) evictOldest();
+        std::size_t offset = allocate(size);
+
+        // Keyframe acuan ikut terbuang saat mencari tempat; tulis ulang sebagai keyframe
+        if (!keyframe && keyframeEntry < first) {
+            keyframe = true;
+            changed.clear();
+            for (int i = 0; i < static_cast<int>(state.size()); ++i) changed.push_back(i);
+            size = EntryHeaderSize + changed.size() * BallSize;
+            if (size > data.size()) return;
+            offset = allocate(size);
+        }
+
+        std::uint8_t* p = data.data() + offset;
+        put<std::int32_t>(p, state.firstContact);
+        put<std::uint16_t>(p, static_cast<std::uint16_t>(changed.size()));
+        for (int i : changed) putBall(p, state, i);
+
+        if (keyframe) {
+            keyframeEntry = next;
+            keyframeState = state;
+        }
+        entry(next) = Entry{ offset, size, keyframeEntry, time, time };
+        ++next;
+    }
+
+public:
+    // capacity: batas byte data snapshot; maxEntries: jumlah frame berbeda yang bisa disimpan.
+    explicit RewindBuffer(std::size_t capacity = 4 << 20, std::size_t maxEntries = 16384, int keyframeEvery = 120)
+        : data(capacity), entries(std::max<std::size_t>(maxEntries, 1)), first(0), next(0),
+          keyframeInterval(keyframeEvery), keyframeEntry(0) {}
+
+    // Simpan keadaan meja pada waktu time (detik, naik monoton).
+    void record(const TableState& state, double time) {
+        if (count() > 0 && sameTable(state, lastState)) {
+            entry(next - 1).endTime = time;
+            return;
+        }
+
+        const int balls = static_cast<int>(state.size());
+        bool keyframe = count() == 0 || keyframeEntry < first || state.size() != keyframeState.size() ||
+                        next - keyframeEntry >= static_cast<std::uint64_t>(keyframeInterval);
+        changed.clear();
+        if (!keyframe) {
+            for (int i = 0; i < balls; ++i) {
+                if (!sameBall(state, keyframeState, i)) changed.push_back(i);
+            }
+            // Delta yang hampir sebesar keyframe lebih baik ditulis sebagai keyframe
+            keyframe = static_cast<int>(changed.size()) * 2 > balls;
+        }
+        if (keyframe) {
+            changed.clear();
+            for (int i = 0; i < balls; ++i) changed.push_back(i);
+        }
+        write(state, time, keyframe);
+        lastState = state;
+    }
+
+    // Pulihkan meja pada waktu time (dibatasi ke rentang yang masih tersimpan).
+    // state harus berisi jumlah bola yang sama dengan saat direkam.
+    bool restore(double time, TableState& state) const {
+        if (count() == 0) return false;
+
+        // Entri terakhir yang dimulai sebelum atau pada time
+        std::uint64_t low = first, high = next - 1;
+        while (low < high) {
+            std::uint64_t mid = low + (high - low + 1) / 2;
+            if (entry(mid).startTime <= time) low = mid;
+            else high = mid - 1;
+        }
+
+        const Entry& found = entry(low);
+        decode(data.data() + entry(found.keyframe).offset, state);
+        if (found.keyframe != low) {
+            decode(data.data() + found.offset, state);
+        }
+        state.storePrevious();
+        return true;
+    }
+
+    // Buang semua frame setelah time, misalnya saat permainan dilanjutkan dari titik rewind.
+    void discardAfter(double time) {
+        while (count() > 0 && entry(next - 1).startTime > time) {
+            --next;
+        }
+        if (count() == 0) return;
+
+        Entry& newest = entry(next - 1);
+        newest.endTime = std::min(newest.endTime, time);
+        keyframeEntry = newest.keyframe;
+        restore(newest.startTime, lastState);
+        decode(data.data() + entry(keyframeEntry).offset, keyframeState);
+    }
+
+    void clear() {
+        first = next = 0;
+    }
+
+    bool empty() const {
+        return count() == 0;
+    }
+
+    double oldestTime() const {
+        return count() > 0 ? entry(first).startTime : 0.0;
+    }
+
+    double newestTime() const {
+        return count() > 0 ? entry(next - 1).endTime : 0.0;
+    }
+
+    std::size_t usedBytes() const {
+        std::size_t used = 0;
+        for (std::uint64_t n = first; n < next; ++n) used += entry(n).size;
+        return used;
+    }
+};
+
+// Keadaan di luar meja (aturan, skor) yang harus ikut mundur bersama RewindBuffer.
+// Nilai baru hanya disimpan bila berbeda dari nilai terakhir (T butuh operator==),
+// jadi satu entri per perubahan, bukan per frame.
+template <typename T>
+class RewindTimeline {
+private:
+    std::deque<std::pair<double, T>> entries;
+
+public:
+    // Simpan nilai pada waktu time (naik monoton, sama dengan RewindBuffer::record).
+    void record(const T& value, double time) {
+        if (!entries.empty() && entries.back().second == value) return;
+        entries.emplace_back(time, value);
+    }
+
+    // Pulihkan nilai yang berlaku pada waktu time.
+    bool restore(double time, T& value) const {
+        for (auto it = entries.rbegin(); it != entries.rend(); ++it) {
+            if (it->first <= time) {
+                value = it->second;
+                return true;
+            }
+        }
+        if (entries.empty()) return false;
+        value = entries.front().second;
+        return true;
+    }
+
+    // Buang nilai setelah time, seperti RewindBuffer::discardAfter.
+    void discardAfter(double time) {
+        while (entries.size() > 1 && entries.back().first > time) {
+            entries.pop_back();
+        }
+    }
+
+    // Buang nilai yang tidak lagi terjangkau: RewindBuffer tidak bisa mundur sebelum time.
+    void trimBefore(double time) {
+        while (entries.size() > 1 && entries[1].first <= time) {
+            entries.pop_front();
+        }
+    }
+};
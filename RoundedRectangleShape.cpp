@@ -1,16 +1,17 @@
 #include <SFML/Graphics.hpp>
 #include <cmath>
+#include <vector>
 
 class RoundedRectangleShape : public sf::Shape {
 public:
     explicit RoundedRectangleShape(const sf::Vector2f& size = sf::Vector2f(0, 0), float radius = 0, std::size_t pointCount = 30) :
         m_size(size), m_radius(radius), m_pointCount(pointCount) {
-        update();
+        computePoints();
     }
 
     void setSize(const sf::Vector2f& size) {
         m_size = size;
-        update();
+        computePoints();
     }
 
     const sf::Vector2f& getSize() const {
@@ -19,7 +20,7 @@ public:
 
     void setCornersRadius(float radius) {
         m_radius = radius;
-        update();
+        computePoints();
     }
 
     float getCornersRadius() const {
@@ -28,7 +29,7 @@ public:
 
     void setPointCount(std::size_t count) {
         m_pointCount = count;
-        update();
+        computePoints();
     }
 
     std::size_t getPointCount() const override {
@@ -36,9 +37,22 @@ public:
     }
 
     sf::Vector2f getPoint(std::size_t index) const override {
-        if (index >= m_pointCount * 4)
+        if (index >= m_points.size())
             return sf::Vector2f(0, 0);
+        return m_points[index];
+    }
 
+private:
+    // Titik sudut dihitung sekali per perubahan ukuran, bukan setiap getPoint()
+    void computePoints() {
+        m_points.resize(m_pointCount * 4);
+        for (std::size_t i = 0; i < m_points.size(); ++i) {
+            m_points[i] = computePoint(i);
+        }
+        update();
+    }
+
+    sf::Vector2f computePoint(std::size_t index) const {
         float deltaAngle = 90.0f / (m_pointCount - 1);
         sf::Vector2f center;
         unsigned int centerIndex = index / m_pointCount;
@@ -55,8 +69,8 @@ public:
                             -m_radius * sin(deltaAngle * (index - centerIndex) * pi / 180) + center.y);
     }
 
-private:
     sf::Vector2f m_size;
     float m_radius;
     std::size_t m_pointCount;
+    std::vector<sf::Vector2f> m_points;
 };
\ No newline at end of file
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "TableState.cpp"
+
+// Grup bola, sama dengan nilai player1Type/player2Type di main.cpp
+enum BallGroup {
+    GroupNone = 0,
+    GroupSolid = 1,
+    GroupStriped = 2
+};
+
+enum Foul {
+    NoFoul,
+    FoulScratch,
+    FoulNoContact,
+    FoulWrongBall
+};
+
+inline int ballGroup(int id) {
+    if (id >= 1 && id <= 7) return GroupSolid;
+    if (id >= 9 && id <= 15) return GroupStriped;
+    return GroupNone;
+}
+
+inline bool isGroupCleared(const TableState& state, int group) {
+    for (std::size_t i = 0; i < state.size(); ++i) {
+        if (ballGroup(static_cast<int>(i)) == group && !state.isPocketed(static_cast<int>(i))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Aturan foul permainan (checkFoul lama di main.cpp), dinilai saat bola putih berhenti:
+// bola putih harus masih bergerak dan bola bernomor playerType ikut bergerak.
+inline Foul checkFoul(const TableState& state, int playerType) {
+    if (state.isPocketed(CueBallIndex)) {
+        return FoulScratch;
+    }
+    if (!state.isMoving(CueBallIndex)) {
+        return FoulNoContact;
+    }
+    if (playerType != -1 && (playerType >= static_cast<int>(state.size()) || !state.isMoving(playerType))) {
+        return FoulWrongBall;
+    }
+    return NoFoul;
+}
+
+// Foul berdasarkan sentuhan pertama bola putih, untuk lawan komputer dan dataset.
+// playerType bernilai -1 bila grup belum dipilih.
+inline Foul findFoul(const TableState& state, int playerType) {
+    if (state.isPocketed(CueBallIndex)) {
+        return FoulScratch;
+    }
+    if (state.firstContact == -1) {
+        return FoulNoContact;
+    }
+    if (playerType != -1 && ballGroup(state.firstContact) != playerType) {
+        bool eightBallAllowed = state.firstContact == 8 && isGroupCleared(state, playerType);
+        if (!eightBallAllowed) {
+            return FoulWrongBall;
+        }
+    }
+    return NoFoul;
+}
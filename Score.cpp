@@ -5,13 +5,13 @@
 
 class Score {
 private:
-    sf::Font font;
+    const sf::Font* font; // dimiliki pemanggil (AssetCache), tidak disalin
     float posX, posY;
     std::vector<std::pair<sf::CircleShape, sf::Text>> scoreCircles; 
     int score; 
 
 public:
-    Score(const sf::Font& font, float x, float y) : font(font), posX(x), posY(y), score(0) {}
+    Score(const sf::Font& font, float x, float y) : font(&font), posX(x), posY(y), score(0) {}
 
     void addScore(int ballID, sf::Color ballColor) {
         sf::CircleShape circle(15.0f); 
@@ -21,7 +21,7 @@ public:
         circle.setPosition(posX + scoreCircles.size() * (2 * 15.0f + 5), posY);
 
         sf::Text text;
-        text.setFont(font);
+        text.setFont(*font);
         text.setString(std::to_string(ballID));
         text.setCharacterSize(14); 
         text.setFillColor(sf::Color::Black);
@@ -33,6 +33,11 @@ public:
         score++; 
     }
 
+    void clear() {
+        scoreCircles.clear();
+        score = 0;
+    }
+
     void draw(sf::RenderWindow& window) {
         for (const auto& pair : scoreCircles) {
             window.draw(pair.first); 
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include "Constants.hpp"
+#include "TableState.cpp"
+
+// Satu pukulan cue: arah gerak bola putih dan kekuatan tarikan stick.
+struct Shot {
+    float angle; // radian
+    float power; // 0 .. MaxCueForce
+};
+
+// Model gaya Stick::endMove: jarak tarikan (startPos - mouse) dibatasi MaxCueForce.
+inline Shot shotFromDrag(float dx, float dy) {
+    Shot shot;
+    shot.angle = std::atan2(dy, dx);
+    shot.power = std::min(std::sqrt(dx * dx + dy * dy), MaxCueForce);
+    return shot;
+}
+
+inline void shotImpulse(const Shot& shot, float& fx, float& fy) {
+    fx = std::cos(shot.angle) * shot.power * CueForceScale;
+    fy = std::sin(shot.angle) * shot.power * CueForceScale;
+}
+
+// Pukul bola putih; catatan kontak dari pukulan sebelumnya dihapus.
+template <typename Real>
+inline void applyShot(BasicTableState<Real>& state, const Shot& shot) {
+    float fx, fy;
+    shotImpulse(shot, fx, fy);
+    state.beginShot();
+    state.applyForce(CueBallIndex, Real(fx), Real(fy));
+}
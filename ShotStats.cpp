@@ -0,0 +1,82 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include "Constants.hpp"
+#include "PhysicsEvents.cpp"
+
+// Statistik satu pukulan yang dikumpulkan dari stream event fisika, untuk
+// pesan setelah giliran dan analitik. Biayanya sebanding dengan jumlah event.
+class ShotStats {
+private:
+    PhysicsEventStream::Reader reader;
+    int ballHits;
+    int cushionHits;
+    int pocketed;
+    int firstContact;
+    float maxImpactSpeed;
+    std::uint32_t firstStep;
+    std::uint32_t lastStep;
+    bool started;
+
+public:
+    explicit ShotStats(const PhysicsEventStream& stream) : reader(stream.reader()) {
+        reset();
+    }
+
+    // Mulai pukulan baru; event yang belum dibaca tetap dihitung ke pukulan ini.
+    void reset() {
+        ballHits = 0;
+        cushionHits = 0;
+        pocketed = 0;
+        firstContact = -1;
+        maxImpactSpeed = 0.0f;
+        firstStep = 0;
+        lastStep = 0;
+        started = false;
+    }
+
+    // Baca event baru dari stream.
+    void update() {
+        reader.drain([this](const PhysicsEvent& event) {
+            if (!started) {
+                firstStep = event.step;
+                started = true;
+            }
+            lastStep = event.step;
+
+            switch (event.type) {
+            case EventFirstContact:
+                firstContact = event.b;
+                break;
+            case EventBallHit:
+                ++ballHits;
+                maxImpactSpeed = std::max(maxImpactSpeed, event.speed);
+                break;
+            case EventCushionHit:
+                ++cushionHits;
+                break;
+            case EventPocketed:
+                ++pocketed;
+                break;
+            default:
+                break;
+            }
+        });
+    }
+
+    int getBallHits() const { return ballHits; }
+    int getCushionHits() const { return cushionHits; }
+    int getPocketed() const { return pocketed; }
+    int getFirstContact() const { return firstContact; }
+    float getMaxImpactSpeed() const { return maxImpactSpeed; }
+
+    // Lama pukulan dari event pertama sampai terakhir, dalam detik simulasi.
+    float getDuration() const {
+        return started ? (lastStep - firstStep) / PhysicsStepRate : 0.0f;
+    }
+
+    std::uint64_t getDropped() const {
+        return reader.getDropped();
+    }
+};
@@ -0,0 +1,191 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "Constants.hpp"
+#include "TableState.cpp"
+#include "UniformGrid.cpp"
+
+// Bola yang diam beberapa langkah berturut-turut "tidur": tidak diintegrasikan,
+// tidak diuji terhadap cushion, dan tidak ikut pasangan broadphase, sehingga
+// biaya per substep sebanding dengan jumlah bola yang bangun. Bola tidur
+// dibangunkan saat kotak sapuan bola yang bergerak menyentuhnya, bersama semua
+// bola yang bersentuhan dengannya (satu pulau), sebelum pasangan diuji.
+//
+// Bola baru tidur bila kecepatannya nol dan posisinya tidak berubah selama
+// SleepSteps langkah, jadi integrasi, cushion, dan tumbukan untuk bola itu
+// memang tidak mengubah apa pun: hasil simulasi sama persis dengan tanpa tidur.
+template <typename Real>
+class BasicSleepIslands {
+private:
+    enum Status : std::uint8_t {
+        Awake,
+        Asleep,
+        Gone   // masuk lubang
+    };
+
+    std::vector<std::uint8_t> status;
+    std::vector<std::uint8_t> restSteps;
+    // Posisi saat tertidur, untuk mendeteksi perubahan dari luar
+    std::vector<Real> restX;
+    std::vector<Real> restY;
+    std::vector<int> awake; // urut naik, sama dengan urutan broadphase
+    std::vector<unsigned> visited;
+    std::vector<int> stack;
+    unsigned visitStamp;
+    int sleeping;
+    bool enabled;
+
+    void setAwake(int i) {
+        if (status[i] == Asleep) --sleeping;
+        status[i] = Awake;
+        restSteps[i] = 0;
+        awake.insert(std::lower_bound(awake.begin(), awake.end(), i), i);
+    }
+
+    void rebuild(const BasicTableState<Real>& state, UniformGrid& grid) {
+        const int count = static_cast<int>(state.size());
+        status.assign(count, Awake);
+        restSteps.assign(count, 0);
+        restX.assign(count, Real(0));
+        restY.assign(count, Real(0));
+        visited.assign(count, 0);
+        awake.clear();
+        sleeping = 0;
+        for (int i = 0; i < count; ++i) {
+            if (state.isPocketed(i)) {
+                status[i] = Gone;
+            } else {
+                awake.push_back(i);
+            }
+        }
+        grid.update(state);
+    }
+
+public:
+    // Langkah berturut-turut tanpa gerak sebelum bola tidur.
+    static constexpr int SleepSteps = 8;
+
+    BasicSleepIslands() : visitStamp(0), sleeping(0), enabled(true) {}
+
+    // Panggil di awal setiap langkah. Bola tidur atau bola di lubang yang diubah
+    // dari luar (pukulan, bola putih dikembalikan, state disalin) dibangunkan.
+    // Hanya membandingkan flag dan posisi, sekali per langkah, bukan per substep.
+    void validate(const BasicTableState<Real>& state, UniformGrid& grid) {
+        const int count = static_cast<int>(state.size());
+        if (count != static_cast<int>(status.size())) {
+            rebuild(state, grid);
+            return;
+        }
+        for (int i = 0; i < count; ++i) {
+            if (status[i] == Gone) {
+                if (!state.isPocketed(i)) setAwake(i);
+            } else if (status[i] == Asleep) {
+                if (state.isPocketed(i) || state.velX[i] != Real(0) || state.velY[i] != Real(0) ||
+                    state.posX[i] != restX[i] || state.posY[i] != restY[i]) {
+                    setAwake(i);
+                }
+            }
+        }
+    }
+
+    // Bangunkan pulau di sekitar bola yang bergerak. contactDistance adalah
+    // jarak dua pusat bola yang bersentuhan; grid harus sudah di-update untuk
+    // bola yang bangun. Panggil sebelum pasangan diuji.
+    void wake(const BasicTableState<Real>& state, const UniformGrid& grid, float contactDistance) {
+        if (sleeping == 0) return;
+
+        // Sedikit longgar supaya pembulatan ke float tidak melewatkan sentuhan
+        const float reach = contactDistance * 1.01f + 0.5f;
+        if (++visitStamp == 0) {
+            std::fill(visited.begin(), visited.end(), 0u);
+            visitStamp = 1;
+        }
+
+        stack.clear();
+        for (int i : awake) {
+            if (!state.isPocketed(i) && (state.velX[i] != Real(0) || state.velY[i] != Real(0))) {
+                visited[i] = visitStamp;
+                stack.push_back(i);
+            }
+        }
+
+        while (!stack.empty()) {
+            int k = stack.back();
+            stack.pop_back();
+
+            // Kotak sapuan sejak awal langkah
+            const float x = static_cast<float>(state.posX[k]);
+            const float y = static_cast<float>(state.posY[k]);
+            const float px = static_cast<float>(state.prevX[k]);
+            const float py = static_cast<float>(state.prevY[k]);
+            const float minX = std::min(x, px), maxX = std::max(x, px);
+            const float minY = std::min(y, py), maxY = std::max(y, py);
+
+            grid.forEachInBox(minX - reach, minY - reach, maxX + reach, maxY + reach, [&](int j) {
+                if (visited[j] == visitStamp) return;
+                const float jx = static_cast<float>(state.posX[j]);
+                const float jy = static_cast<float>(state.posY[j]);
+                const float dx = jx - std::min(std::max(jx, minX), maxX);
+                const float dy = jy - std::min(std::max(jy, minY), maxY);
+                if (dx * dx + dy * dy > reach * reach) return;
+
+                visited[j] = visitStamp;
+                if (status[j] == Asleep) setAwake(j);
+                stack.push_back(j);
+            });
+        }
+    }
+
+    // Panggil di akhir setiap langkah: bola yang diam cukup lama ditidurkan.
+    void settle(const BasicTableState<Real>& state) {
+        std::size_t kept = 0;
+        for (int i : awake) {
+            if (state.isPocketed(i)) {
+                status[i] = Gone;
+                continue;
+            }
+            bool still = state.velX[i] == Real(0) && state.velY[i] == Real(0) &&
+                         state.posX[i] == state.prevX[i] && state.posY[i] == state.prevY[i];
+            restSteps[i] = still ? static_cast<std::uint8_t>(std::min(restSteps[i] + 1, SleepSteps)) : 0;
+            if (enabled && restSteps[i] >= SleepSteps) {
+                status[i] = Asleep;
+                restX[i] = state.posX[i];
+                restY[i] = state.posY[i];
+                ++sleeping;
+                continue;
+            }
+            awake[kept++] = i;
+        }
+        awake.resize(kept);
+    }
+
+    // Matikan untuk perbandingan; semua bola yang tidur langsung dibangunkan.
+    void setEnabled(bool value) {
+        enabled = value;
+        if (enabled) return;
+        for (int i = 0; i < static_cast<int>(status.size()); ++i) {
+            if (status[i] == Asleep) setAwake(i);
+        }
+    }
+
+    bool isEnabled() const {
+        return enabled;
+    }
+
+    bool isAwake(int i) const {
+        return status[i] == Awake;
+    }
+
+    // Bola yang bangun dan belum masuk lubang, urut naik.
+    const std::vector<int>& getAwake() const {
+        return awake;
+    }
+
+    int getSleepingCount() const {
+        return sleeping;
+    }
+};
+
+typedef BasicSleepIslands<float> SleepIslands;
@@ -1,15 +1,17 @@
 #include <SFML/Graphics.hpp>
 #include "Constants.hpp"
+#include "AssetCache.cpp"
 #include <iostream>
 
 class StartMenu {
 public:
-    StartMenu() {
-        if (!backgroundTexture.loadFromFile("D:/sfmll/bg/menu-bg.jpg")) {
+    explicit StartMenu(AssetCache& assets) {
+        backgroundTexture = assets.texture("bg/menu-bg.jpg");
+        if (!backgroundTexture) {
             std::cerr << "Failed to load background image!" << std::endl;
         } else {
-            backgroundSprite.setTexture(backgroundTexture);
-            sf::Vector2u windowSize = backgroundTexture.getSize();
+            backgroundSprite.setTexture(*backgroundTexture);
+            sf::Vector2u windowSize = backgroundTexture->getSize();
             sf::Vector2f scaleFactor(
                 static_cast<float>(BackWidth) / windowSize.x,
                 static_cast<float>(BackHeight) / windowSize.y
@@ -19,7 +21,7 @@ public:
     }
     ~StartMenu() {}
 
-    void show(sf::RenderWindow& window, sf::Font& font) {
+    void show(sf::RenderWindow& window, const sf::Font& font) {
         window.clear();
         window.draw(backgroundSprite);
         drawText(window, "Billiard Game", font, 50, window.getSize().x / 2, 100);
@@ -27,9 +29,10 @@ public:
         window.display();
     }
 
+    // Menu statis: blokir sampai ada input supaya tidak memakan CPU.
     bool handleInput(sf::RenderWindow& window) {
         sf::Event event;
-        while (window.pollEvent(event)) {
+        for (bool pending = window.waitEvent(event); pending; pending = window.pollEvent(event)) {
             if (event.type == sf::Event::Closed) {
                 window.close();
                 return false;
@@ -42,11 +45,11 @@ public:
     }
 
 private:
-    void drawText(sf::RenderWindow& window, const std::string& text, sf::Font& font, unsigned int size, float x, float y) {
+    void drawText(sf::RenderWindow& window, const std::string& text, const sf::Font& font, unsigned int size, float x, float y) {
         sf::Text drawText(text, font, size);
         drawText.setPosition(x - drawText.getLocalBounds().width / 2, y);
         window.draw(drawText);
     }
-    sf::Texture backgroundTexture;
+    std::shared_ptr<sf::Texture> backgroundTexture;
     sf::Sprite backgroundSprite;
 };
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include <SFML/Graphics.hpp>
 #include "Ball.cpp"
+#include "AimPredictor.cpp"
 #include <cmath>
 #include <vector>
 
@@ -13,15 +14,16 @@ private:
     float offsetDistance;
     const float stickLength;
     bool isReleased;
-    std::vector<sf::VertexArray> dashedLine;
+    AimPredictor aimLine;
     sf::RectangleShape powerBar; // Bar kekuatan
     sf::RectangleShape powerBarBackground; // Latar belakang bar kekuatan
 
 public:
-    Stick()
+    explicit Stick(const TableGeometry& geometry = defaultTableGeometry(), float ballRadius = BallRadius)
         : stickShape(sf::TriangleStrip, 4), 
           shadowShape(sf::TriangleStrip, 4), 
-          isMoving(false), maxForce(2000.0f), offsetDistance(350.0f), stickLength(550.0f), isReleased(false) {
+          isMoving(false), maxForce(MaxCueForce), offsetDistance(350.0f), stickLength(550.0f), isReleased(false),
+          aimLine(geometry, ballRadius) {
         stickShape[0].color = sf::Color(245, 222, 179); 
         stickShape[1].color = sf::Color(245, 222, 179); 
         stickShape[2].color = sf::Color(160, 82, 45);   
@@ -47,22 +49,20 @@ public:
         startPos = ballPosition;
     }
 
-    void endMove(Ball& ball, const sf::Vector2f& mousePosition) {
-        if (!isMoving) return;
+    // Mengembalikan true bila bola dipukul; shot berisi sudut dan power yang dipakai.
+    bool endMove(Ball& ball, const sf::Vector2f& mousePosition, Shot& shot) {
+        if (!isMoving) return false;
 
         sf::Vector2f force = startPos - mousePosition;
-        float distance = std::sqrt(force.x * force.x + force.y * force.y);
-
-        float forceMagnitude = std::min(distance, maxForce);
-
-        sf::Vector2f normalizedForce = force / std::sqrt(force.x * force.x + force.y * force.y);
-        ball.applyForce(normalizedForce * forceMagnitude * 2.0f);
+        shot = shotFromDrag(force.x, force.y);
+        ball.strike(shot);
 
         isReleased = true;
         isMoving = false;
+        return true;
     }
 
-    void update(sf::Vector2f ballPosition, sf::Vector2f mousePosition) {
+    void update(const TableState& state, sf::Vector2f ballPosition, sf::Vector2f mousePosition) {
         if (isMoving) {
             sf::Vector2f direction = mousePosition - ballPosition;
             float distance = std::sqrt(direction.x * direction.x + direction.y * direction.y);
@@ -95,48 +95,29 @@ public:
             shadowShape[2].position = stickShape[2].position + shadowOffset;
             shadowShape[3].position = stickShape[3].position + shadowOffset;
 
-            // Update dashed line
-            dashedLine.clear();
-            const float dashLength = 5.0f;
-            const float gapLength = 5.0f;
-            const float totalLength = 500.0f; // Length of the dashed line
-            sf::Vector2f currentPoint = ballPosition;
-
-            float remainingLength = totalLength;
-
-            while (remainingLength > 0) {
-                float segmentLength = std::min(dashLength, remainingLength);
-                sf::Vector2f nextPoint = currentPoint - normalizedDirection * segmentLength;
-
-                sf::VertexArray segment(sf::Lines, 2);
-                segment[0].position = currentPoint;
-                segment[1].position = nextPoint;
-                segment[0].color = sf::Color::White;
-                segment[1].color = sf::Color::White;
-
-                dashedLine.push_back(segment);
-
-                currentPoint = nextPoint - normalizedDirection * gapLength; // Skip the gap
-                remainingLength -= (dashLength + gapLength);
-            }
+            // Update prediksi garis bidik (hanya dihitung ulang bila bidikan berubah)
+            sf::Vector2f drag = startPos - mousePosition;
+            aimLine.update(state, shotFromDrag(drag.x, drag.y));
 
             // Update power bar
             float forceMagnitude = std::min(distance, maxForce);
             float powerBarWidth = (forceMagnitude / maxForce) * 200.0f;
             powerBar.setSize(sf::Vector2f(powerBarWidth, 20.0f));
         } else if (isReleased) {
-            dashedLine.clear();
+            aimLine.clear();
             isReleased = false;
         }
     }
 
+    bool isDragging() const {
+        return isMoving;
+    }
+
     void draw(sf::RenderWindow& window) {
         if (isMoving) {
             window.draw(shadowShape); 
             window.draw(stickShape);  
-            for (auto& segment : dashedLine) {
-                window.draw(segment);
-            }
+            window.draw(aimLine);
             window.draw(powerBarBackground); 
             window.draw(powerBar); 
         }
@@ -0,0 +1,326 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "Constants.hpp"
+#include "TableState.cpp"
+
+// Ukuran meja, lubang, dan rak. Ada dua bentuk dengan nama anggota yang sama:
+//   - struct konfigurasi (ClassicTable, Table7ft, ...) dengan anggota static
+//     constexpr, dipakai sebagai parameter template sehingga batas dan radius
+//     di loop fisika menjadi konstanta yang dilipat compiler;
+//   - TableProfile, nilai runtime yang bisa dimuat dari file.
+// Kode generik menerima `const Config& config` dan membaca config.ballRadius,
+// config.left(), dan seterusnya; keduanya bekerja tanpa perubahan.
+//
+// Semua ukuran dalam unit layout (piksel meja). Meja regulasi memakai skala
+// LayoutPerInch; ClassicTable adalah meja bawaan permainan dari Constants.hpp.
+
+enum RackStyle {
+    RackEightBall,  // segitiga 15 bola di foot spot
+    RackSnooker     // segitiga 15 merah di belakang pink, enam bola warna di spot-nya
+};
+
+struct RackSpot {
+    float x, y;
+};
+
+constexpr float LayoutPerInch = 10.0f;
+
+struct ClassicTable {
+    static constexpr const char* name = "classic";
+    static constexpr float width = TableWidth;
+    static constexpr float height = TableHeight;
+    static constexpr float border = TableBorder;
+    static constexpr float ballRadius = BallRadius;
+    static constexpr float pocketRadius = PocketRadius;     // lubang yang digambar
+    static constexpr float cornerMouth = PocketRadius * 1.5f; // jarak sudut ke ujung cushion
+    static constexpr float sideMouth = PocketRadius;          // setengah bukaan lubang tengah
+    static constexpr float jawRadius = 2.0f;
+    static constexpr float captureRadius = PocketCaptureRadius;
+    static constexpr int ballCount = 16;
+    static constexpr RackStyle rackStyle = RackEightBall;
+    static constexpr float cueX = 200.0f;
+    static constexpr float cueY = 330.0f;
+    static constexpr float rackX = 650.0f;  // bola depan segitiga
+    static constexpr float rackY = 330.0f;
+    static constexpr float rackColumnSpacing = 35.0f;
+    static constexpr float rackRowSpacing = 40.0f;
+
+    static constexpr float left() { return border; }
+    static constexpr float top() { return border; }
+    static constexpr float right() { return border + width; }
+    static constexpr float bottom() { return border + height; }
+};
+
+// Bola dan lubang pool (WPA): bola 2 1/4", lubang sudut sekitar 4 3/4".
+struct PoolEquipment {
+    static constexpr float border = 4.0f * LayoutPerInch;
+    static constexpr float ballRadius = 1.125f * LayoutPerInch;
+    static constexpr float pocketRadius = 2.4f * LayoutPerInch;
+    static constexpr float cornerMouth = 3.4f * LayoutPerInch;
+    static constexpr float sideMouth = 2.6f * LayoutPerInch;
+    static constexpr float jawRadius = 0.2f * LayoutPerInch;
+    static constexpr int ballCount = 16;
+    static constexpr RackStyle rackStyle = RackEightBall;
+};
+
+// Bola dan lubang snooker: bola 52,5 mm, lubang lebih sempit dari pool.
+struct SnookerEquipment {
+    static constexpr float border = 4.0f * LayoutPerInch;
+    static constexpr float ballRadius = 1.03f * LayoutPerInch;
+    static constexpr float pocketRadius = 1.8f * LayoutPerInch;
+    static constexpr float cornerMouth = 2.5f * LayoutPerInch;
+    static constexpr float sideMouth = 2.05f * LayoutPerInch;
+    static constexpr float jawRadius = 0.3f * LayoutPerInch;
+    static constexpr int ballCount = 22;
+    static constexpr RackStyle rackStyle = RackSnooker;
+};
+
+// Meja regulasi dengan area main WidthTenths x HeightTenths (per 0,1 inci).
+// Bola putih di head spot, segitiga di foot spot (snooker: tepat di belakang pink).
+template <int WidthTenths, int HeightTenths, typename Equipment>
+struct RegulationTable : Equipment {
+    static constexpr float width = WidthTenths * LayoutPerInch / 10;
+    static constexpr float height = HeightTenths * LayoutPerInch / 10;
+    static constexpr float captureRadius = Equipment::pocketRadius + Equipment::ballRadius / 2;
+    static constexpr float rackRowSpacing = 2 * Equipment::ballRadius + 0.02f * LayoutPerInch;
+    static constexpr float rackColumnSpacing = rackRowSpacing * 0.8660254f;
+    static constexpr float cueX = Equipment::border + width / 4;
+    static constexpr float cueY = Equipment::border + height / 2;
+    static constexpr float rackX = Equipment::border + width * 3 / 4 + (Equipment::rackStyle == RackSnooker ? rackRowSpacing : 0.0f);
+    static constexpr float rackY = Equipment::border + height / 2;
+
+    static constexpr float left() { return Equipment::border; }
+    static constexpr float top() { return Equipment::border; }
+    static constexpr float right() { return Equipment::border + width; }
+    static constexpr float bottom() { return Equipment::border + height; }
+};
+
+struct Table7ft : RegulationTable<780, 390, PoolEquipment> {
+    static constexpr const char* name = "7ft";
+};
+
+struct Table8ft : RegulationTable<880, 440, PoolEquipment> {
+    static constexpr const char* name = "8ft";
+};
+
+struct Table9ft : RegulationTable<1000, 500, PoolEquipment> {
+    static constexpr const char* name = "9ft";
+};
+
+struct Snooker12ft : RegulationTable<1397, 698, SnookerEquipment> {
+    static constexpr const char* name = "snooker";
+};
+
+// Konfigurasi meja runtime, misalnya dari file atau pilihan pemain.
+struct TableProfile {
+    std::string name;
+    float width, height, border;
+    float ballRadius, pocketRadius;
+    float cornerMouth, sideMouth, jawRadius, captureRadius;
+    int ballCount;
+    RackStyle rackStyle;
+    float cueX, cueY, rackX, rackY;
+    float rackColumnSpacing, rackRowSpacing;
+
+    float left() const { return border; }
+    float top() const { return border; }
+    float right() const { return border + width; }
+    float bottom() const { return border + height; }
+
+    template <typename Config>
+    static TableProfile from(const Config& config) {
+        TableProfile p;
+        p.name = config.name;
+        p.width = config.width;
+        p.height = config.height;
+        p.border = config.border;
+        p.ballRadius = config.ballRadius;
+        p.pocketRadius = config.pocketRadius;
+        p.cornerMouth = config.cornerMouth;
+        p.sideMouth = config.sideMouth;
+        p.jawRadius = config.jawRadius;
+        p.captureRadius = config.captureRadius;
+        p.ballCount = config.ballCount;
+        p.rackStyle = config.rackStyle;
+        p.cueX = config.cueX;
+        p.cueY = config.cueY;
+        p.rackX = config.rackX;
+        p.rackY = config.rackY;
+        p.rackColumnSpacing = config.rackColumnSpacing;
+        p.rackRowSpacing = config.rackRowSpacing;
+        return p;
+    }
+};
+
+// Profil bawaan berdasarkan nama: classic, 7ft, 8ft, 9ft, snooker.
+inline bool findTableProfile(const std::string& name, TableProfile& profile) {
+    if (name == ClassicTable::name) profile = TableProfile::from(ClassicTable());
+    else if (name == Table7ft::name) profile = TableProfile::from(Table7ft());
+    else if (name == Table8ft::name) profile = TableProfile::from(Table8ft());
+    else if (name == Table9ft::name) profile = TableProfile::from(Table9ft());
+    else if (name == Snooker12ft::name) profile = TableProfile::from(Snooker12ft());
+    else return false;
+    return true;
+}
+
+// Anggota ukuran profil dengan nama key, atau nullptr. positive diisi true untuk
+// ukuran yang harus lebih dari nol (dipakai sebagai pembagi dan radius tumbukan).
+inline float* tableProfileSize(TableProfile& profile, const std::string& key, bool& positive) {
+    positive = true;
+    if (key == "width") return &profile.width;
+    if (key == "height") return &profile.height;
+    if (key == "ballRadius") return &profile.ballRadius;
+    if (key == "pocketRadius") return &profile.pocketRadius;
+    if (key == "cornerMouth") return &profile.cornerMouth;
+    if (key == "sideMouth") return &profile.sideMouth;
+    if (key == "jawRadius") return &profile.jawRadius;
+    if (key == "captureRadius") return &profile.captureRadius;
+    if (key == "rackColumnSpacing") return &profile.rackColumnSpacing;
+    if (key == "rackRowSpacing") return &profile.rackRowSpacing;
+
+    positive = false;
+    if (key == "border") return &profile.border;
+    if (key == "cueX") return &profile.cueX;
+    if (key == "cueY") return &profile.cueY;
+    if (key == "rackX") return &profile.rackX;
+    if (key == "rackY") return &profile.rackY;
+    return nullptr;
+}
+
+// Muat profil dari file teks "kunci = nilai", satu per baris, '#' untuk komentar.
+// Kunci "base" memuat profil bawaan sebagai titik awal, kunci lain menimpa
+// anggota dengan nama yang sama. Posisi rak tidak dihitung ulang otomatis.
+// Nilai yang bukan angka, atau ukuran yang tidak positif, ditolak dengan nomor barisnya.
+inline bool loadTableProfile(const std::string& path, TableProfile& profile) {
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "Profil meja tidak ditemukan: " << path << std::endl;
+        return false;
+    }
+
+    profile = TableProfile::from(ClassicTable());
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        line = line.substr(0, line.find('#'));
+        std::size_t equals = line.find('=');
+        if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+
+        std::string key, value;
+        std::istringstream keyStream(line.substr(0, equals));
+        keyStream >> key;
+        if (equals != std::string::npos) {
+            std::istringstream valueStream(line.substr(equals + 1));
+            valueStream >> value;
+        }
+        if (key.empty() || value.empty()) {
+            std::cerr << path << ":" << lineNumber << ": baris tidak valid" << std::endl;
+            return false;
+        }
+
+        bool positive;
+        if (key == "base") {
+            if (!findTableProfile(value, profile)) {
+                std::cerr << path << ":" << lineNumber << ": profil tidak dikenal: " << value << std::endl;
+                return false;
+            }
+        }
+        else if (key == "name") profile.name = value;
+        else if (key == "rackStyle") profile.rackStyle = (value == "snooker") ? RackSnooker : RackEightBall;
+        else if (key == "ballCount") {
+            char* end = nullptr;
+            long count = std::strtol(value.c_str(), &end, 10);
+            if (*end != '\0' || count < 1 || count > 1000) {
+                std::cerr << path << ":" << lineNumber << ": ballCount harus bilangan bulat 1..1000: " << value << std::endl;
+                return false;
+            }
+            profile.ballCount = static_cast<int>(count);
+        }
+        else if (float* size = tableProfileSize(profile, key, positive)) {
+            char* end = nullptr;
+            float number = std::strtof(value.c_str(), &end);
+            if (*end != '\0' || !std::isfinite(number)) {
+                std::cerr << path << ":" << lineNumber << ": " << key << " bukan angka: " << value << std::endl;
+                return false;
+            }
+            if (positive && number <= 0.0f) {
+                std::cerr << path << ":" << lineNumber << ": " << key << " harus lebih dari nol: " << value << std::endl;
+                return false;
+            }
+            *size = number;
+        }
+        else {
+            std::cerr << path << ":" << lineNumber << ": kunci tidak dikenal: " << key << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Pilihan --table: nama profil bawaan, atau path file profil bila bukan nama.
+inline bool selectTableProfile(const std::string& nameOrPath, TableProfile& profile) {
+    return findTableProfile(nameOrPath, profile) || loadTableProfile(nameOrPath, profile);
+}
+
+// Permainan dan server memakai aturan 8-ball: 16 bola dengan rak segitiga.
+inline bool isEightBallProfile(const TableProfile& profile) {
+    return profile.ballCount == 16 && profile.rackStyle == RackEightBall;
+}
+
+// Posisi awal semua bola: indeks 0 bola putih, lalu segitiga kolom demi kolom
+// dari bola depan. Snooker menambah kuning, hijau, cokelat, biru, pink, hitam.
+template <typename Config>
+std::vector<RackSpot> rackSpots(const Config& config) {
+    std::vector<RackSpot> spots;
+    const float centerY = config.top() + config.height / 2;
+    const int triangle = std::min(config.ballCount - 1, 15);
+    const int colours = (config.rackStyle == RackSnooker) ? std::min(config.ballCount - 1 - triangle, 6) : 0;
+
+    // Garis baulk, radius D, dan spot hitam mengikuti proporsi meja 12 kaki.
+    const float baulkX = config.left() + config.width * 0.2076f;
+    const float radiusD = config.width * 0.0823f;
+    if (config.rackStyle == RackSnooker) {
+        spots.push_back({ baulkX - radiusD * 0.5f, centerY + radiusD * 0.5f });
+    } else {
+        spots.push_back({ config.cueX, config.cueY });
+    }
+
+    for (int column = 0, placed = 0; placed < triangle; ++column) {
+        for (int row = 0; row <= column && placed < triangle; ++row, ++placed) {
+            spots.push_back({ config.rackX + column * config.rackColumnSpacing,
+                              config.rackY - column * config.rackRowSpacing / 2 + row * config.rackRowSpacing });
+        }
+    }
+
+    const RackSpot colourSpots[6] = {
+        { baulkX, centerY + radiusD },                                     // kuning
+        { baulkX, centerY - radiusD },                                     // hijau
+        { baulkX, centerY },                                               // cokelat
+        { config.left() + config.width / 2, centerY },                     // biru
+        { config.left() + config.width * 3 / 4, centerY },                 // pink
+        { config.right() - config.width * 0.0913f, centerY }               // hitam
+    };
+    for (int k = 0; k < colours; ++k) {
+        spots.push_back(colourSpots[k]);
+    }
+    return spots;
+}
+
+// Rak awal sebagai state fisika dengan presisi Real.
+template <typename Real = float, typename Config>
+BasicTableState<Real> makeRack(const Config& config) {
+    BasicTableState<Real> state;
+    for (const RackSpot& spot : rackSpots(config)) {
+        state.addBall(Real(spot.x), Real(spot.y));
+    }
+    return state;
+}
@@ -0,0 +1,320 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "Constants.hpp"
+#include "TableState.cpp"
+#include "TableConfig.cpp"
+#include "PhysicsEvents.cpp"
+
+// Geometri tumbukan meja yang dikompilasi sekali saat start: segmen cushion,
+// rahang (jaw) di ujung setiap segmen, dan lingkaran tangkap lubang dengan
+// radius kuadrat yang sudah dihitung. Semua primitif disimpan dalam BVH kecil
+// sehingga setiap bola hanya memeriksa primitif di dekatnya.
+class TableGeometry {
+public:
+    enum PrimitiveType {
+        CushionPrimitive,
+        JawPrimitive,
+        PocketPrimitive
+    };
+
+    // Garis cushion dari (ax, ay) ke (bx, by); normal (nx, ny) mengarah ke dalam meja
+    struct Cushion {
+        float ax, ay, bx, by;
+        float tx, ty;   // arah satuan dari a ke b
+        float nx, ny;
+        float length;
+    };
+
+    // Ujung membulat di mulut lubang
+    struct Jaw {
+        float cx, cy;
+        float radius;
+    };
+
+    struct Pocket {
+        float cx, cy;
+        float radiusSquared;
+    };
+
+private:
+    struct Primitive {
+        PrimitiveType type;
+        int index;
+        float minX, minY, maxX, maxY;
+    };
+
+    struct Node {
+        float minX, minY, maxX, maxY;
+        int left, right;   // -1 untuk leaf
+        int start, count;  // rentang di primitives untuk leaf
+    };
+
+    std::vector<Cushion> cushions;
+    std::vector<Jaw> jaws;
+    std::vector<Pocket> pockets;
+    std::vector<Primitive> primitives;
+    std::vector<Node> nodes;
+    float left, top, right, bottom; // garis cushion
+
+    void addCushion(float ax, float ay, float bx, float by, float jawRadius) {
+        Cushion c;
+        c.ax = ax; c.ay = ay; c.bx = bx; c.by = by;
+        c.length = std::sqrt((bx - ax) * (bx - ax) + (by - ay) * (by - ay));
+        c.tx = (bx - ax) / c.length;
+        c.ty = (by - ay) / c.length;
+        // Titik tengah meja selalu berada di sisi dalam
+        c.nx = -c.ty;
+        c.ny = c.tx;
+        float midX = (left + right) / 2;
+        float midY = (top + bottom) / 2;
+        if ((midX - ax) * c.nx + (midY - ay) * c.ny < 0) {
+            c.nx = -c.nx;
+            c.ny = -c.ny;
+        }
+        cushions.push_back(c);
+
+        // Rahang sedikit di luar garis cushion supaya bola yang menyusuri cushion tetap bisa masuk
+        jaws.push_back({ ax - c.nx * jawRadius, ay - c.ny * jawRadius, jawRadius });
+        jaws.push_back({ bx - c.nx * jawRadius, by - c.ny * jawRadius, jawRadius });
+    }
+
+    void addPrimitive(PrimitiveType type, int index, float minX, float minY, float maxX, float maxY) {
+        primitives.push_back({ type, index, minX, minY, maxX, maxY });
+    }
+
+    int build(int start, int count) {
+        Node node;
+        node.minX = node.minY = 1e30f;
+        node.maxX = node.maxY = -1e30f;
+        for (int k = start; k < start + count; ++k) {
+            node.minX = std::min(node.minX, primitives[k].minX);
+            node.minY = std::min(node.minY, primitives[k].minY);
+            node.maxX = std::max(node.maxX, primitives[k].maxX);
+            node.maxY = std::max(node.maxY, primitives[k].maxY);
+        }
+        node.left = node.right = -1;
+        node.start = start;
+        node.count = count;
+
+        int self = static_cast<int>(nodes.size());
+        nodes.push_back(node);
+        if (count <= 2) return self;
+
+        // Bagi di tengah sumbu terpanjang
+        bool splitX = (node.maxX - node.minX) >= (node.maxY - node.minY);
+        std::sort(primitives.begin() + start, primitives.begin() + start + count,
+                  [splitX](const Primitive& a, const Primitive& b) {
+                      return splitX ? (a.minX + a.maxX) < (b.minX + b.maxX) : (a.minY + a.maxY) < (b.minY + b.maxY);
+                  });
+        int half = count / 2;
+        int leftChild = build(start, half);
+        int rightChild = build(start + half, count - half);
+        nodes[self].left = leftChild;
+        nodes[self].right = rightChild;
+        return self;
+    }
+
+public:
+    // Meja persegi dengan enam lubang. (leftX, topY, rightX, bottomY) adalah garis cushion.
+    TableGeometry(float leftX, float topY, float rightX, float bottomY,
+                  float cornerMouth, float sideMouth, float jawRadius, float captureRadius)
+        : left(leftX), top(topY), right(rightX), bottom(bottomY) {
+        const float midX = (left + right) / 2;
+
+        addCushion(left + cornerMouth, top, midX - sideMouth, top, jawRadius);
+        addCushion(midX + sideMouth, top, right - cornerMouth, top, jawRadius);
+        addCushion(left + cornerMouth, bottom, midX - sideMouth, bottom, jawRadius);
+        addCushion(midX + sideMouth, bottom, right - cornerMouth, bottom, jawRadius);
+        addCushion(left, top + cornerMouth, left, bottom - cornerMouth, jawRadius);
+        addCushion(right, top + cornerMouth, right, bottom - cornerMouth, jawRadius);
+
+        const float columns[3] = { left, midX, right };
+        for (int p = 0; p < 6; ++p) {
+            pockets.push_back({ columns[p % 3], (p < 3) ? top : bottom, captureRadius * captureRadius });
+        }
+
+        for (int k = 0; k < static_cast<int>(cushions.size()); ++k) {
+            const Cushion& c = cushions[k];
+            addPrimitive(CushionPrimitive, k, std::min(c.ax, c.bx), std::min(c.ay, c.by), std::max(c.ax, c.bx), std::max(c.ay, c.by));
+        }
+        for (int k = 0; k < static_cast<int>(jaws.size()); ++k) {
+            const Jaw& j = jaws[k];
+            addPrimitive(JawPrimitive, k, j.cx - j.radius, j.cy - j.radius, j.cx + j.radius, j.cy + j.radius);
+        }
+        for (int k = 0; k < static_cast<int>(pockets.size()); ++k) {
+            float r = std::sqrt(pockets[k].radiusSquared);
+            addPrimitive(PocketPrimitive, k, pockets[k].cx - r, pockets[k].cy - r, pockets[k].cx + r, pockets[k].cy + r);
+        }
+        build(0, static_cast<int>(primitives.size()));
+    }
+
+    // Panggil callback(type, index) untuk setiap primitif yang kotaknya beririsan dengan kotak query.
+    template <typename Callback>
+    void query(float minX, float minY, float maxX, float maxY, Callback&& callback) const {
+        int stack[32];
+        int depth = 0;
+        stack[depth++] = 0;
+        while (depth > 0) {
+            const Node& node = nodes[stack[--depth]];
+            if (node.maxX < minX || node.minX > maxX || node.maxY < minY || node.minY > maxY) continue;
+
+            if (node.left == -1) {
+                for (int k = node.start; k < node.start + node.count; ++k) {
+                    const Primitive& p = primitives[k];
+                    if (p.maxX < minX || p.minX > maxX || p.maxY < minY || p.minY > maxY) continue;
+                    callback(p.type, p.index);
+                }
+            } else {
+                stack[depth++] = node.left;
+                stack[depth++] = node.right;
+            }
+        }
+    }
+
+    // Indeks lubang yang menangkap titik (x, y), atau -1.
+    int findPocket(float x, float y) const {
+        int found = -1;
+        query(x, y, x, y, [&](PrimitiveType type, int index) {
+            if (type != PocketPrimitive || found != -1) return;
+            float dx = x - pockets[index].cx;
+            float dy = y - pockets[index].cy;
+            if (dx * dx + dy * dy < pockets[index].radiusSquared) {
+                found = index;
+            }
+        });
+        return found;
+    }
+
+    int nearestPocket(float x, float y) const {
+        int nearest = 0;
+        float best = 1e30f;
+        for (int p = 0; p < static_cast<int>(pockets.size()); ++p) {
+            float dx = x - pockets[p].cx;
+            float dy = y - pockets[p].cy;
+            if (dx * dx + dy * dy < best) {
+                best = dx * dx + dy * dy;
+                nearest = p;
+            }
+        }
+        return nearest;
+    }
+
+    // Bola yang melewati garis cushion hanya bisa lewat mulut lubang
+    bool isOutside(float x, float y) const {
+        return x < left || x > right || y < top || y > bottom;
+    }
+
+    // Tumbukan satu bola dengan cushion dan rahang, lalu periksa lubang.
+    // Mengembalikan indeks lubang bila bola masuk, atau -1. Geometri disimpan
+    // dalam float; untuk Real lain konstantanya dikonversi, dan BVH di-query
+    // dengan posisi yang dibulatkan ke float. Pantulan dan bola masuk
+    // diterbitkan ke sink (lihat PhysicsEvents.cpp).
+    template <typename Real, typename Sink>
+    int collideBall(BasicTableState<Real>& state, int i, float radius, const Sink& sink) const {
+        Real& x = state.posX[i];
+        Real& y = state.posY[i];
+        Real& vx = state.velX[i];
+        Real& vy = state.velY[i];
+        const Real r(radius);
+        int pocket = -1;
+
+        const float fx = static_cast<float>(x);
+        const float fy = static_cast<float>(y);
+        query(fx - radius, fy - radius, fx + radius, fy + radius, [&](PrimitiveType type, int index) {
+            if (pocket != -1) return;
+
+            if (type == CushionPrimitive) {
+                const Cushion& c = cushions[index];
+                const Real ax(c.ax), ay(c.ay), nx(c.nx), ny(c.ny);
+                Real along = (x - ax) * Real(c.tx) + (y - ay) * Real(c.ty);
+                if (along < Real(0) || along > Real(c.length)) return;
+
+                Real distance = (x - ax) * nx + (y - ay) * ny;
+                if (distance >= r) return;
+
+                Real normalSpeed = vx * nx + vy * ny;
+                if (normalSpeed < Real(0)) {
+                    vx -= Real(2) * normalSpeed * nx;
+                    vy -= Real(2) * normalSpeed * ny;
+                    sink.publish(EventCushionHit, i, index, static_cast<float>(x), static_cast<float>(y),
+                                 -static_cast<float>(normalSpeed));
+                }
+                x += (r - distance) * nx;
+                y += (r - distance) * ny;
+            } else if (type == JawPrimitive) {
+                const Jaw& j = jaws[index];
+                Real dx = x - Real(j.cx);
+                Real dy = y - Real(j.cy);
+                Real reach = r + Real(j.radius);
+                Real distanceSquared = dx * dx + dy * dy;
+                if (distanceSquared >= reach * reach || distanceSquared == Real(0)) return;
+
+                Real distance = squareRoot(distanceSquared);
+                Real nx = dx / distance;
+                Real ny = dy / distance;
+                Real normalSpeed = vx * nx + vy * ny;
+                if (normalSpeed < Real(0)) {
+                    vx -= Real(2) * normalSpeed * nx;
+                    vy -= Real(2) * normalSpeed * ny;
+                    sink.publish(EventCushionHit, i, -1, static_cast<float>(x), static_cast<float>(y),
+                                 -static_cast<float>(normalSpeed));
+                }
+                x += (reach - distance) * nx;
+                y += (reach - distance) * ny;
+            } else {
+                const Pocket& p = pockets[index];
+                Real dx = x - Real(p.cx);
+                Real dy = y - Real(p.cy);
+                if (dx * dx + dy * dy < Real(p.radiusSquared)) {
+                    pocket = index;
+                }
+            }
+        });
+
+        if (pocket == -1 && isOutside(static_cast<float>(x), static_cast<float>(y))) {
+            pocket = nearestPocket(static_cast<float>(x), static_cast<float>(y));
+        }
+        if (pocket != -1) {
+            sink.publish(EventPocketed, i, pocket, static_cast<float>(x), static_cast<float>(y),
+                         static_cast<float>(squareRoot(vx * vx + vy * vy)));
+            vx = Real(0);
+            vy = Real(0);
+            state.setFlag(i, BallPocketed, true);
+        }
+        return pocket;
+    }
+
+    template <typename Real>
+    int collideBall(BasicTableState<Real>& state, int i, float radius) const {
+        return collideBall(state, i, radius, NullEventSink());
+    }
+
+    // Geometri dari konfigurasi meja (lihat TableConfig.cpp).
+    template <typename Config>
+    explicit TableGeometry(const Config& config)
+        : TableGeometry(config.left(), config.top(), config.right(), config.bottom(),
+                        config.cornerMouth, config.sideMouth, config.jawRadius, config.captureRadius) {}
+
+    const std::vector<Cushion>& getCushions() const { return cushions; }
+    const std::vector<Jaw>& getJaws() const { return jaws; }
+    const std::vector<Pocket>& getPockets() const { return pockets; }
+    float getLeft() const { return left; }
+    float getTop() const { return top; }
+    float getRight() const { return right; }
+    float getBottom() const { return bottom; }
+};
+
+// Geometri untuk konfigurasi meja compile-time, dikompilasi sekali per tipe.
+template <typename Config>
+inline const TableGeometry& tableGeometry() {
+    static const TableGeometry geometry{ Config() };
+    return geometry;
+}
+
+// Geometri meja standar dari Constants.hpp.
+inline const TableGeometry& defaultTableGeometry() {
+    return tableGeometry<ClassicTable>();
+}
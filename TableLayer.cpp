@@ -0,0 +1,46 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <functional>
+
+// Lapisan statis (latar, meja, lubang) yang digambar sekali ke RenderTexture
+// lalu ditampilkan sebagai satu sprite. Dibangun ulang hanya bila ukuran
+// window berubah atau invalidate() dipanggil (misalnya konfigurasi meja berubah).
+class TableLayer : public sf::Drawable {
+private:
+    sf::RenderTexture texture;
+    sf::Sprite sprite;
+    sf::Vector2u builtSize;
+    sf::Vector2f worldSize;
+    bool dirty;
+
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override {
+        target.draw(sprite, states);
+    }
+
+public:
+    explicit TableLayer(const sf::Vector2f& size)
+        : builtSize(0, 0), worldSize(size), dirty(true) {}
+
+    void invalidate() {
+        dirty = true;
+    }
+
+    // paint menggambar isi lapisan dalam koordinat dunia (0..worldSize).
+    void update(const sf::Vector2u& windowSize, const std::function<void(sf::RenderTarget&)>& paint) {
+        if (!dirty && windowSize == builtSize) return;
+
+        // Tekstur mengikuti ukuran piksel window supaya tetap tajam setelah resize
+        texture.create(windowSize.x, windowSize.y);
+        texture.setView(sf::View(sf::FloatRect(0.0f, 0.0f, worldSize.x, worldSize.y)));
+        texture.clear();
+        paint(texture);
+        texture.display();
+
+        sprite.setTexture(texture.getTexture(), true);
+        sprite.setScale(worldSize.x / windowSize.x, worldSize.y / windowSize.y);
+
+        builtSize = windowSize;
+        dirty = false;
+    }
+};
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "Constants.hpp"
+#include "TableState.cpp"
+#include "TableConfig.cpp"
+#include "TableGeometry.cpp"
+#include "FixedStepClock.cpp"
+#include "PhysicsEvents.cpp"
+#include "MatchRules.cpp"
+#include "BallSlots.cpp"
+#include "Shot.cpp"
+
+// Satu meja tanpa window untuk server: state fisika, jam langkah tetap, aturan
+// pertandingan, dan bot sederhana untuk kedua pemain. Setiap sesi berdiri
+// sendiri, jadi sesi berbeda boleh di-tick bersamaan dari thread berbeda.
+class TableSession {
+private:
+    TableState rack;
+    TableState state;
+    PhysicsEventStream events;
+    PhysicsEventStream::Reader pocketEvents;
+    BasicFixedStepClock<float, TableProfile> clock;
+    MatchRules rules;
+    BallSlots<int> balls; // slot aktif = bola yang masih di meja
+    std::mt19937 rng;
+    int shots;
+    bool resting;
+    bool finished;
+
+    void placeCueBall() {
+        state.posX[CueBallIndex] = state.prevX[CueBallIndex] = rack.posX[CueBallIndex];
+        state.posY[CueBallIndex] = state.prevY[CueBallIndex] = rack.posY[CueBallIndex];
+        state.velX[CueBallIndex] = 0.0f;
+        state.velY[CueBallIndex] = 0.0f;
+        state.setFlag(CueBallIndex, BallPocketed, false);
+    }
+
+    // Sama dengan penanganan bola masuk di main.cpp, tanpa Score dan pesan.
+    void handlePockets() {
+        pocketEvents.drain([this](const PhysicsEvent& event) {
+            const int i = event.a;
+            if (event.type != EventPocketed || finished || !balls.isActive(i)) return;
+
+            PocketResult result = rules.pocket(i);
+            balls.deactivate(i);
+            finished = result.kind == PocketEight;
+        });
+    }
+
+public:
+    // Batas pukulan per pertandingan; setelah itu pertandingan dianggap seri.
+    static const int MaxShots = 200;
+
+    // startRack harus dibuat dari profile yang sama; geometry harus hidup lebih lama dari sesi ini.
+    TableSession(const TableState& startRack, unsigned seed, const TableProfile& profile = TableProfile::from(ClassicTable()),
+                 const TableGeometry& geometry = defaultTableGeometry())
+        : rack(startRack), state(startRack), events(1024), pocketEvents(events.reader()), clock(state, profile, geometry), rng(seed),
+          shots(0), resting(true), finished(false) {
+        clock.setEventStream(&events);
+        for (std::size_t i = 0; i < state.size(); ++i) {
+            balls.add(static_cast<int>(i));
+        }
+    }
+
+    TableSession(const TableSession&) = delete;
+    TableSession& operator=(const TableSession&) = delete;
+
+    // Mulai pertandingan baru dari rak awal.
+    void reset() {
+        state = rack;
+        state.storePrevious();
+        rules = MatchRules();
+        pocketEvents.skip();
+        for (std::size_t i = 0; i < balls.size(); ++i) {
+            balls.activate(static_cast<int>(i));
+        }
+        shots = 0;
+        resting = true;
+        finished = false;
+    }
+
+    // Bot: bidik lurus ke bola sah acak dengan sedikit noise.
+    Shot chooseShot() {
+        int group = rules.getPlayerType(rules.getCurrentPlayer());
+        bool eightAllowed = group != -1 && isGroupCleared(state, group);
+
+        std::vector<int> targets;
+        for (int i = balls.first(); i != -1; i = balls.next(i)) {
+            if (i == CueBallIndex) continue;
+            bool legal = eightAllowed ? i == 8 : (i != 8 && (group == -1 || ballGroup(i) == group));
+            if (legal) targets.push_back(i);
+        }
+
+        std::normal_distribution<float> noise(0.0f, 0.03f);
+        std::uniform_real_distribution<float> power(0.3f * MaxCueForce, MaxCueForce);
+        Shot shot;
+        if (targets.empty()) {
+            std::uniform_real_distribution<float> angle(-3.14159265f, 3.14159265f);
+            shot.angle = angle(rng);
+        } else {
+            int target = targets[std::uniform_int_distribution<std::size_t>(0, targets.size() - 1)(rng)];
+            shot.angle = std::atan2(state.posY[target] - state.posY[CueBallIndex],
+                                    state.posX[target] - state.posX[CueBallIndex]) + noise(rng);
+        }
+        shot.power = power(rng);
+        return shot;
+    }
+
+    // Pukulan pemain yang sedang giliran; meja harus diam.
+    void shoot(const Shot& shot) {
+        applyShot(state, shot);
+        ++shots;
+        resting = false;
+    }
+
+    // Jalankan sampai steps langkah fisika lalu proses bola masuk dan giliran,
+    // seperti satu frame di main.cpp. Berhenti lebih awal bila meja sudah diam.
+    void tick(int steps) {
+        for (int s = 0; s < steps && state.anyMoving(); ++s) {
+            clock.tick();
+        }
+        handlePockets();
+        rules.update(state);
+
+        if (!state.anyMoving()) {
+            // Bola putih yang masuk dikembalikan setelah meja diam, seperti main.cpp
+            if (!balls.isActive(CueBallIndex)) {
+                placeCueBall();
+                balls.activate(CueBallIndex);
+            }
+            resting = true;
+            finished = finished || shots >= MaxShots;
+        }
+    }
+
+    // Meja diam dan menunggu pukulan berikutnya; tidak perlu di-tick.
+    bool isResting() const {
+        return resting;
+    }
+
+    bool isFinished() const {
+        return finished;
+    }
+
+    // Pemenang (1 atau 2), 0 bila seri karena batas pukulan.
+    int getWinner() const {
+        return rules.getWinner();
+    }
+
+    int getShotCount() const {
+        return shots;
+    }
+
+    const TableState& getState() const {
+        return state;
+    }
+};
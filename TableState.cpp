@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Constants.hpp"
+#include "Precision.cpp"
+
+// Bit flag per bola di TableState::flags
+enum BallFlag : std::uint8_t {
+    BallPocketed = 1 << 0,
+    BallHit = 1 << 1
+};
+
+// Bola putih selalu berada di slot 0
+const int CueBallIndex = 0;
+
+// Seluruh state fisika meja dalam array paralel (struct-of-arrays).
+// Posisi memakai koordinat meja (tanpa OFFSET_X/OFFSET_Y), jadi simulasi
+// bisa berjalan tanpa window maupun objek SFML. Real adalah tipe angka dari
+// Precision.cpp; permainan memakai TableState (float).
+template <typename Real>
+struct BasicTableState {
+    std::vector<Real> posX;
+    std::vector<Real> posY;
+    std::vector<Real> velX;
+    std::vector<Real> velY;
+    std::vector<std::uint8_t> flags;
+    // Posisi pada langkah fisika sebelumnya, untuk interpolasi render
+    std::vector<Real> prevX;
+    std::vector<Real> prevY;
+    // Bola pertama yang disentuh bola putih sejak pukulan terakhir, -1 bila belum ada
+    int firstContact = -1;
+
+    int addBall(Real x, Real y) {
+        posX.push_back(x);
+        posY.push_back(y);
+        velX.push_back(Real(0));
+        velY.push_back(Real(0));
+        flags.push_back(0);
+        prevX.push_back(x);
+        prevY.push_back(y);
+        return static_cast<int>(posX.size()) - 1;
+    }
+
+    std::size_t size() const {
+        return posX.size();
+    }
+
+    bool hasFlag(int i, std::uint8_t flag) const {
+        return (flags[i] & flag) != 0;
+    }
+
+    void setFlag(int i, std::uint8_t flag, bool status) {
+        if (status) {
+            flags[i] |= flag;
+        } else {
+            flags[i] &= static_cast<std::uint8_t>(~flag);
+        }
+    }
+
+    bool isPocketed(int i) const {
+        return hasFlag(i, BallPocketed);
+    }
+
+    Real speedSquared(int i) const {
+        return velX[i] * velX[i] + velY[i] * velY[i];
+    }
+
+    bool isMoving(int i) const {
+        return speedSquared(i) > Real(MinVelocity * MinVelocity);
+    }
+
+    bool anyMoving() const {
+        for (std::size_t i = 0; i < size(); ++i) {
+            if (!isPocketed(static_cast<int>(i)) && isMoving(static_cast<int>(i))) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void storePrevious() {
+        prevX = posX;
+        prevY = posY;
+    }
+
+    float renderX(int i, float alpha) const {
+        return static_cast<float>(prevX[i] + (posX[i] - prevX[i]) * Real(alpha));
+    }
+
+    float renderY(int i, float alpha) const {
+        return static_cast<float>(prevY[i] + (posY[i] - prevY[i]) * Real(alpha));
+    }
+
+    // Catat tumbukan antara bola i dan j untuk aturan foul.
+    void recordHit(int i, int j) {
+        setFlag(i, BallHit, true);
+        setFlag(j, BallHit, true);
+        if (firstContact == -1) {
+            if (i == CueBallIndex) firstContact = j;
+            else if (j == CueBallIndex) firstContact = i;
+        }
+    }
+
+    // Dipanggil setiap kali pukulan baru dimulai.
+    void beginShot() {
+        firstContact = -1;
+        for (std::size_t i = 0; i < size(); ++i) {
+            flags[i] &= static_cast<std::uint8_t>(~BallHit);
+        }
+    }
+
+    void applyForce(int i, Real fx, Real fy) {
+        velX[i] += fx;
+        velY[i] += fy;
+    }
+};
+
+typedef BasicTableState<float> TableState;
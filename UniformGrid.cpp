@@ -0,0 +1,179 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "Constants.hpp"
+#include "TableState.cpp"
+#include "TableConfig.cpp"
+
+// Broadphase grid seragam di atas area meja. Setiap sel berukuran kira-kira
+// satu diameter bola, jadi pasangan kandidat hanya datang dari 3x3 sel tetangga.
+// Setiap sel menyimpan linked list bola (head/next/prev), sehingga bola yang
+// pindah sel cukup dilepas dan disambung ulang tanpa membangun grid dari nol.
+class UniformGrid {
+private:
+    float cellSize;
+    float originX;
+    float originY;
+    int cols;
+    int rows;
+    std::vector<int> head;
+    std::vector<int> next;
+    std::vector<int> prev;
+    std::vector<int> cellOf;
+
+    int cellIndex(float x, float y) const {
+        int cx = static_cast<int>((x - originX) / cellSize);
+        int cy = static_cast<int>((y - originY) / cellSize);
+        cx = std::min(std::max(cx, 0), cols - 1);
+        cy = std::min(std::max(cy, 0), rows - 1);
+        return cy * cols + cx;
+    }
+
+    void link(int i, int cell) {
+        prev[i] = -1;
+        next[i] = head[cell];
+        if (head[cell] != -1) {
+            prev[head[cell]] = i;
+        }
+        head[cell] = i;
+        cellOf[i] = cell;
+    }
+
+    void unlink(int i) {
+        int cell = cellOf[i];
+        if (cell == -1) return;
+
+        if (prev[i] != -1) {
+            next[prev[i]] = next[i];
+        } else {
+            head[cell] = next[i];
+        }
+        if (next[i] != -1) {
+            prev[next[i]] = prev[i];
+        }
+        cellOf[i] = -1;
+    }
+
+public:
+    UniformGrid(float cell = 2 * BallRadius, float left = TableBorder, float top = TableBorder,
+                float width = TableWidth, float height = TableHeight)
+        : cellSize(cell), originX(left), originY(top),
+          cols(std::max(1, static_cast<int>(std::ceil(width / cell)))),
+          rows(std::max(1, static_cast<int>(std::ceil(height / cell)))),
+          head(cols * rows, -1) {}
+
+    // Grid yang menutupi area main konfigurasi meja (lihat TableConfig.cpp).
+    template <typename Config>
+    explicit UniformGrid(const Config& config)
+        : UniformGrid(2 * config.ballRadius, config.left(), config.top(), config.width, config.height) {}
+
+    // Sinkronkan grid dengan posisi terbaru; hanya bola yang pindah sel yang disentuh.
+    template <typename Real>
+    void update(const BasicTableState<Real>& state) {
+        const int count = static_cast<int>(state.size());
+        if (static_cast<int>(cellOf.size()) < count) {
+            next.resize(count, -1);
+            prev.resize(count, -1);
+            cellOf.resize(count, -1);
+        }
+
+        for (int i = 0; i < count; ++i) {
+            if (state.isPocketed(i)) {
+                unlink(i);
+                continue;
+            }
+            int cell = cellIndex(static_cast<float>(state.posX[i]), static_cast<float>(state.posY[i]));
+            if (cell != cellOf[i]) {
+                unlink(i);
+                link(i, cell);
+            }
+        }
+    }
+
+    // Seperti update(), tetapi hanya untuk bola di indices; grid harus sudah
+    // pernah di-update untuk seluruh state.
+    template <typename Real>
+    void update(const BasicTableState<Real>& state, const std::vector<int>& indices) {
+        for (int i : indices) {
+            if (state.isPocketed(i)) {
+                unlink(i);
+                continue;
+            }
+            int cell = cellIndex(static_cast<float>(state.posX[i]), static_cast<float>(state.posY[i]));
+            if (cell != cellOf[i]) {
+                unlink(i);
+                link(i, cell);
+            }
+        }
+    }
+
+    void clear() {
+        std::fill(head.begin(), head.end(), -1);
+        std::fill(cellOf.begin(), cellOf.end(), -1);
+    }
+
+    // Panggil callback(i, j) untuk setiap pasangan kandidat dengan i < j.
+    template <typename Callback>
+    void forEachPair(Callback&& callback) const {
+        const int count = static_cast<int>(cellOf.size());
+        for (int i = 0; i < count; ++i) {
+            int cell = cellOf[i];
+            if (cell == -1) continue;
+
+            int cx = cell % cols;
+            int cy = cell / cols;
+            for (int ny = std::max(cy - 1, 0); ny <= std::min(cy + 1, rows - 1); ++ny) {
+                for (int nx = std::max(cx - 1, 0); nx <= std::min(cx + 1, cols - 1); ++nx) {
+                    for (int j = head[ny * cols + nx]; j != -1; j = next[j]) {
+                        if (j > i) {
+                            callback(i, j);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // Seperti forEachPair(), tetapi hanya dari bola di indices (urut naik) ke
+    // tetangga yang lolos include(j). Urutan pasangan sama dengan forEachPair()
+    // tanpa pasangan yang disaring.
+    template <typename Include, typename Callback>
+    void forEachPair(const std::vector<int>& indices, Include&& include, Callback&& callback) const {
+        for (int i : indices) {
+            int cell = cellOf[i];
+            if (cell == -1) continue;
+
+            int cx = cell % cols;
+            int cy = cell / cols;
+            for (int ny = std::max(cy - 1, 0); ny <= std::min(cy + 1, rows - 1); ++ny) {
+                for (int nx = std::max(cx - 1, 0); nx <= std::min(cx + 1, cols - 1); ++nx) {
+                    for (int j = head[ny * cols + nx]; j != -1; j = next[j]) {
+                        if (j > i && include(j)) {
+                            callback(i, j);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // Panggil callback(j) untuk setiap bola di sel yang beririsan dengan kotak.
+    template <typename Callback>
+    void forEachInBox(float minX, float minY, float maxX, float maxY, Callback&& callback) const {
+        int first = cellIndex(minX, minY);
+        int last = cellIndex(maxX, maxY);
+        for (int ny = first / cols; ny <= last / cols; ++ny) {
+            for (int nx = first % cols; nx <= last % cols; ++nx) {
+                for (int j = head[ny * cols + nx]; j != -1; j = next[j]) {
+                    callback(j);
+                }
+            }
+        }
+    }
+
+    float getCellSize() const {
+        return cellSize;
+    }
+};
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Thread pool dengan satu antrean per worker. Worker mengambil tugas dari
+// ujung antreannya sendiri dan mencuri dari depan antrean worker lain saat
+// kosong, jadi tugas yang tidak seimbang tetap tersebar ke semua core.
+class WorkStealingPool {
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> threads;
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    std::condition_variable idle;
+    std::atomic<int> pending; // tugas yang belum selesai
+    std::atomic<int> queued;  // tugas yang masih menunggu di antrean
+    std::atomic<unsigned> nextQueue;
+    bool stopping;
+
+    // Pool pemilik thread ini dan indeks worker-nya. Disimpan bersama supaya
+    // worker dari pool lain yang memanggil submit() tidak memakai antrean yang salah.
+    struct WorkerSlot {
+        const WorkStealingPool* pool;
+        int index;
+    };
+
+    static WorkerSlot& workerSlot() {
+        thread_local WorkerSlot slot = { nullptr, -1 };
+        return slot;
+    }
+
+    // Indeks worker di pool ini, -1 untuk thread di luar pool ini.
+    int workerIndex() const {
+        const WorkerSlot& slot = workerSlot();
+        return slot.pool == this ? slot.index : -1;
+    }
+
+    bool tryPop(int self, std::function<void()>& task) {
+        {
+            Queue& own = *queues[self];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.tasks.empty()) {
+                task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+                queued.fetch_sub(1);
+                return true;
+            }
+        }
+        const int count = static_cast<int>(queues.size());
+        for (int offset = 1; offset < count; ++offset) {
+            Queue& victim = *queues[(self + offset) % count];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                queued.fetch_sub(1);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void run(int self) {
+        workerSlot() = WorkerSlot{ this, self };
+        std::function<void()> task;
+        while (true) {
+            if (tryPop(self, task)) {
+                task();
+                task = nullptr;
+                if (pending.fetch_sub(1) == 1) {
+                    std::lock_guard<std::mutex> lock(sleepMutex);
+                    idle.notify_all();
+                }
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            wake.wait(lock, [this] { return stopping || queued.load() > 0; });
+            if (stopping && queued.load() <= 0) {
+                return;
+            }
+        }
+    }
+
+public:
+    explicit WorkStealingPool(unsigned threadCount = std::thread::hardware_concurrency())
+        : pending(0), queued(0), nextQueue(0), stopping(false) {
+        threadCount = std::max(1u, threadCount);
+        for (unsigned i = 0; i < threadCount; ++i) {
+            queues.push_back(std::unique_ptr<Queue>(new Queue()));
+        }
+        for (unsigned i = 0; i < threadCount; ++i) {
+            threads.emplace_back(&WorkStealingPool::run, this, static_cast<int>(i));
+        }
+    }
+
+    ~WorkStealingPool() {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    void submit(std::function<void()> task) {
+        int self = workerIndex();
+        unsigned target = (self >= 0) ? static_cast<unsigned>(self) : nextQueue.fetch_add(1) % queues.size();
+        pending.fetch_add(1);
+        {
+            std::lock_guard<std::mutex> lock(queues[target]->mutex);
+            queues[target]->tasks.push_back(std::move(task));
+        }
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        queued.fetch_add(1);
+        wake.notify_one();
+    }
+
+    // Tunggu sampai semua tugas yang sudah dikirim selesai.
+    void wait() {
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        idle.wait(lock, [this] { return pending.load() == 0; });
+    }
+
+    std::size_t size() const {
+        return threads.size();
+    }
+
+    // Indeks worker pool ini yang sedang menjalankan tugas, -1 di luar pool ini.
+    int currentWorker() const {
+        return workerIndex();
+    }
+};
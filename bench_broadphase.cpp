@@ -0,0 +1,70 @@
+// Benchmark broadphase: loop semua pasangan vs UniformGrid.
+// Build: g++ -std=c++17 -O2 bench_broadphase.cpp -o bench_broadphase
+//
+// Titik potong tergantung mesin dan compiler: baca baris "Grid lebih cepat mulai
+// dari N bola" di akhir output, jangan angka yang ditulis tangan.
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include "TableState.cpp"
+#include "UniformGrid.cpp"
+#include "Physics.cpp"
+
+// Meja "many balls": n bola tersebar acak dengan kecepatan acak.
+TableState makeStressTable(int count, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> x(TableBorder + BallRadius, TableBorder + TableWidth - BallRadius);
+    std::uniform_real_distribution<float> y(TableBorder + BallRadius, TableBorder + TableHeight - BallRadius);
+    std::uniform_real_distribution<float> v(-800.0f, 800.0f);
+
+    TableState state;
+    for (int i = 0; i < count; ++i) {
+        int index = state.addBall(x(rng), y(rng));
+        state.applyForce(index, v(rng), v(rng));
+    }
+    return state;
+}
+
+template <typename StepFunction>
+double nsPerStep(int count, int steps, StepFunction&& stepFunction) {
+    TableState state = makeStressTable(count, 1234);
+    const float deltaTime = 1.0f / (PhysicsStepRate * PhysicsSubsteps);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int s = 0; s < steps; ++s) {
+        stepFunction(state, deltaTime);
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / steps;
+}
+
+int main() {
+    const int counts[] = { 8, 16, 32, 64, 128, 256, 512, 1024, 2048, 4096 };
+    int crossover = -1;
+
+    std::printf("%8s %16s %16s %10s\n", "balls", "all-pairs ns", "grid ns", "speedup");
+    for (int count : counts) {
+        int steps = count <= 256 ? 2000 : 200;
+
+        double bruteForce = nsPerStep(count, steps, [](TableState& state, float deltaTime) {
+            step(state, deltaTime);
+        });
+
+        UniformGrid grid;
+        double gridded = nsPerStep(count, steps, [&grid](TableState& state, float deltaTime) {
+            step(state, deltaTime, grid);
+        });
+
+        std::printf("%8d %16.0f %16.0f %9.2fx\n", count, bruteForce, gridded, bruteForce / gridded);
+        if (crossover == -1 && gridded < bruteForce) {
+            crossover = count;
+        }
+    }
+
+    if (crossover != -1) {
+        std::printf("Grid lebih cepat mulai dari %d bola.\n", crossover);
+    } else {
+        std::printf("Grid tidak lebih cepat pada ukuran yang diuji.\n");
+    }
+    return 0;
+}
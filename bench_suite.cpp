@@ -0,0 +1,383 @@
+// Benchmark fisika, aturan, dan prediksi bidikan tanpa window.
+// Hasil ditulis sebagai JSON ke stdout (atau ke file bila diberi argumen).
+// Build: g++ -std=c++17 -O2 bench_suite.cpp -o bench_suite -pthread
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+#include "TableState.cpp"
+#include "Physics.cpp"
+#include "FixedStepClock.cpp"
+#include "EventEngine.cpp"
+#include "TableGeometry.cpp"
+#include "TableConfig.cpp"
+#include "PhysicsEvents.cpp"
+#include "Rules.cpp"
+#include "Shot.cpp"
+
+// Hitung alokasi heap supaya alokasi per langkah bisa dilaporkan
+static std::atomic<std::uint64_t> allocationCount(0);
+
+void* operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+struct Result {
+    std::string name;
+    std::uint64_t ops;
+    double seconds;
+    std::uint64_t allocations;
+};
+
+// Meja "many balls": n bola tersebar acak dengan kecepatan acak.
+TableState makeStressTable(int count, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> x(TableBorder + BallRadius, TableBorder + TableWidth - BallRadius);
+    std::uniform_real_distribution<float> y(TableBorder + BallRadius, TableBorder + TableHeight - BallRadius);
+    std::uniform_real_distribution<float> v(-800.0f, 800.0f);
+
+    TableState state;
+    for (int i = 0; i < count; ++i) {
+        int index = state.addBall(x(rng), y(rng));
+        state.applyForce(index, v(rng), v(rng));
+    }
+    return state;
+}
+
+// Jalankan body(ops) dan catat waktu serta alokasi; body mengembalikan jumlah operasi.
+template <typename Body>
+Result measure(const std::string& name, Body&& body) {
+    std::uint64_t allocationsBefore = allocationCount.load();
+    auto start = std::chrono::steady_clock::now();
+    std::uint64_t ops = body();
+    auto end = std::chrono::steady_clock::now();
+    return Result{ name, ops, std::chrono::duration<double>(end - start).count(), allocationCount.load() - allocationsBefore };
+}
+
+// Setara Ball::update: integrasi gerak semua bola satu langkah.
+Result benchIntegrate() {
+    TableState state = makeStressTable(16, 1);
+    const float deltaTime = 1.0f / (PhysicsStepRate * PhysicsSubsteps);
+    return measure("integrate", [&] {
+        const int steps = 2000000;
+        for (int s = 0; s < steps; ++s) {
+            integrateAll(state, deltaTime);
+        }
+        return static_cast<std::uint64_t>(steps) * 16;
+    });
+}
+
+// Setara checkCollision: uji dan respons tumbukan untuk semua pasangan rak.
+Result benchCollision() {
+    TableState rack = makeRack(ClassicTable());
+    return measure("resolve_collision", [&] {
+        const int rounds = 200000;
+        std::uint64_t pairs = 0;
+        for (int r = 0; r < rounds; ++r) {
+            rack.velX[0] = (r & 1) ? 500.0f : -500.0f;
+            for (int i = 0; i < 16; ++i) {
+                for (int j = i + 1; j < 16; ++j) {
+                    resolveCollision(rack, i, j);
+                    ++pairs;
+                }
+            }
+        }
+        return pairs;
+    });
+}
+
+// Setara PoolTable::isPocketed: uji lubang untuk titik acak di seluruh meja.
+Result benchPocket() {
+    const TableGeometry& geometry = defaultTableGeometry();
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> x(0.0f, WindowWidth), y(0.0f, WindowHeight);
+    std::vector<float> points;
+    for (int k = 0; k < 4096; ++k) {
+        points.push_back(x(rng));
+        points.push_back(y(rng));
+    }
+
+    return measure("is_pocketed", [&] {
+        const int rounds = 2000;
+        int found = 0;
+        for (int r = 0; r < rounds; ++r) {
+            for (std::size_t k = 0; k < points.size(); k += 2) {
+                found += geometry.findPocket(points[k], points[k + 1]) >= 0;
+            }
+        }
+        if (found < 0) std::printf("%d", found);
+        return static_cast<std::uint64_t>(rounds) * (points.size() / 2);
+    });
+}
+
+// Aturan foul sentuhan pertama (findFoul) setelah satu pukulan.
+Result benchFoul() {
+    TableState state = makeRack(ClassicTable());
+    state.setFlag(3, BallPocketed, true);
+    return measure("check_foul", [&] {
+        const int rounds = 5000000;
+        int fouls = 0;
+        for (int r = 0; r < rounds; ++r) {
+            state.firstContact = (r % 17) - 1;
+            fouls += findFoul(state, (r & 1) ? GroupSolid : GroupStriped) != NoFoul;
+        }
+        if (fouls < 0) std::printf("%d", fouls);
+        return static_cast<std::uint64_t>(rounds);
+    });
+}
+
+// Setara Stick::update: prediksi garis bidik AimPredictor sampai kontak pertama bola putih.
+Result benchAim() {
+    TableState rack = makeRack(ClassicTable());
+    TableState scratch;
+    EventEngine engine(scratch);
+    return measure("aim_prediction", [&] {
+        const int rounds = 20000;
+        for (int r = 0; r < rounds; ++r) {
+            scratch = rack;
+            applyShot(scratch, Shot{ -0.6f + 1.2f * r / rounds, 1200.0f });
+            engine.reset();
+
+            EventEngine::EventRecord record;
+            bool bounced = false;
+            for (int n = 0; n < 64 && engine.processNext(record); ++n) {
+                bool involvesCue = record.a == CueBallIndex || (record.type == EventEngine::BallBall && record.b == CueBallIndex);
+                if (!involvesCue) continue;
+                if (record.type == EventEngine::Cushion && !bounced) {
+                    bounced = true;
+                    continue;
+                }
+                break;
+            }
+        }
+        return static_cast<std::uint64_t>(rounds);
+    });
+}
+
+// Break standar dari rak main.cpp sampai semua bola diam.
+Result scenarioBreak() {
+    TableState state = makeRack(ClassicTable());
+    FixedStepClock clock(state);
+    applyShot(state, Shot{ 0.0f, MaxCueForce });
+    return measure("break", [&] {
+        std::uint64_t steps = 0;
+        while (state.anyMoving()) {
+            clock.tick();
+            ++steps;
+        }
+        return steps;
+    });
+}
+
+// Break yang sama dengan stream event terpasang dan satu pembaca yang menghabiskannya tiap langkah.
+Result scenarioBreakStream() {
+    TableState state = makeRack(ClassicTable());
+    PhysicsEventStream events;
+    PhysicsEventStream::Reader reader = events.reader();
+    FixedStepClock clock(state);
+    clock.setEventStream(&events);
+    applyShot(state, Shot{ 0.0f, MaxCueForce });
+    return measure("break_event_stream", [&] {
+        std::uint64_t steps = 0;
+        int pocketed = 0;
+        while (state.anyMoving()) {
+            clock.tick();
+            reader.drain([&pocketed](const PhysicsEvent& event) {
+                pocketed += event.type == EventPocketed;
+            });
+            ++steps;
+        }
+        if (pocketed < 0) std::printf("%d", pocketed);
+        return steps;
+    });
+}
+
+// Break yang sama dengan presisi lain (double, Fixed32) dari Precision.cpp.
+template <typename Real>
+Result scenarioBreakPrecision() {
+    BasicTableState<Real> state = makeRack<Real>(ClassicTable());
+    BasicFixedStepClock<Real> clock(state);
+    applyShot(state, Shot{ 0.0f, MaxCueForce });
+    return measure(std::string("break_") + precisionName<Real>(), [&] {
+        std::uint64_t steps = 0;
+        while (state.anyMoving()) {
+            clock.tick();
+            ++steps;
+        }
+        return steps;
+    });
+}
+
+// Break di meja lain dengan konfigurasi compile-time (radius dan batas konstan).
+template <typename Config>
+Result scenarioBreakTable() {
+    TableState state = makeRack(Config());
+    BasicFixedStepClock<float, Config> clock(state);
+    applyShot(state, Shot{ 0.0f, MaxCueForce });
+    return measure(std::string("break_") + Config::name, [&] {
+        std::uint64_t steps = 0;
+        while (state.anyMoving()) {
+            clock.tick();
+            ++steps;
+        }
+        return steps;
+    });
+}
+
+// Break yang sama dengan meja sebagai TableProfile runtime; bandingkan dengan scenarioBreakTable.
+template <typename Config>
+Result scenarioBreakProfile() {
+    TableProfile profile = TableProfile::from(Config());
+    TableGeometry geometry(profile);
+    TableState state = makeRack(profile);
+    BasicFixedStepClock<float, TableProfile> clock(state, profile, geometry);
+    applyShot(state, Shot{ 0.0f, MaxCueForce });
+    return measure("break_" + profile.name + "_profile", [&] {
+        std::uint64_t steps = 0;
+        while (state.anyMoving()) {
+            clock.tick();
+            ++steps;
+        }
+        return steps;
+    });
+}
+
+// Break yang sama, dilompati per event dengan segmen gerak analitik. Setiap operasi adalah satu event.
+Result scenarioBreakEvents() {
+    TableState rack = makeRack(ClassicTable());
+    TableState state;
+    EventEngine engine(state);
+    return measure("break_events", [&] {
+        const int rounds = 1000;
+        std::uint64_t events = 0;
+        for (int r = 0; r < rounds; ++r) {
+            state = rack;
+            applyShot(state, Shot{ 0.0f, MaxCueForce });
+            engine.reset();
+            std::uint64_t before = engine.getProcessedEvents();
+            engine.runToRest();
+            events += engine.getProcessedEvents() - before;
+        }
+        return events;
+    });
+}
+
+// Pukulan pelan di tengah permainan: rak setelah break, 2-4 bola bergerak per
+// pukulan. sleeping=false mematikan tidur bola untuk perbandingan.
+Result scenarioMidgame(bool sleeping) {
+    TableState layout = makeRack(ClassicTable());
+    {
+        FixedStepClock clock(layout);
+        applyShot(layout, Shot{ 0.0f, MaxCueForce });
+        while (layout.anyMoving()) {
+            clock.tick();
+        }
+        layout.setFlag(CueBallIndex, BallPocketed, false);
+    }
+
+    std::mt19937 rng(13);
+    std::uniform_real_distribution<float> angle(-3.14159265f, 3.14159265f), power(200.0f, 700.0f);
+    TableState state = layout;
+    FixedStepClock clock(state);
+    clock.setSleeping(sleeping);
+    return measure(sleeping ? "midgame_shots" : "midgame_shots_nosleep", [&] {
+        std::uint64_t steps = 0;
+        for (int shot = 0; shot < 2000; ++shot) {
+            state = layout;
+            applyShot(state, Shot{ angle(rng), power(rng) });
+            while (state.anyMoving()) {
+                clock.tick();
+                ++steps;
+            }
+        }
+        return steps;
+    });
+}
+
+// 1000 bola acak dengan broadphase grid.
+Result scenarioStress() {
+    TableState state = makeStressTable(1000, 7);
+    FixedStepClock clock(state);
+    return measure("stress_1000", [&] {
+        const int steps = 2000;
+        for (int s = 0; s < steps; ++s) {
+            clock.tick();
+        }
+        return static_cast<std::uint64_t>(steps);
+    });
+}
+
+// 10.000 pukulan acak dari rak, masing-masing sampai diam. Setiap operasi adalah satu langkah fisika.
+Result scenarioBatch() {
+    TableState rack = makeRack(ClassicTable());
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> angle(-3.14159265f, 3.14159265f), power(200.0f, MaxCueForce);
+    TableState state;
+    return measure("shot_batch_10000", [&] {
+        std::uint64_t steps = 0;
+        for (int shot = 0; shot < 10000; ++shot) {
+            state = rack;
+            FixedStepClock clock(state);
+            applyShot(state, Shot{ angle(rng), power(rng) });
+            while (state.anyMoving()) {
+                clock.tick();
+                ++steps;
+            }
+        }
+        return steps;
+    });
+}
+
+void writeResults(std::FILE* out, const char* key, const std::vector<Result>& results, bool steps) {
+    std::fprintf(out, "  \"%s\": [\n", key);
+    for (std::size_t k = 0; k < results.size(); ++k) {
+        const Result& r = results[k];
+        double nsPerOp = r.seconds * 1e9 / r.ops;
+        std::fprintf(out, "    { \"name\": \"%s\", \"ops\": %llu, \"ns_per_op\": %.3f", r.name.c_str(),
+                     static_cast<unsigned long long>(r.ops), nsPerOp);
+        if (steps) {
+            std::fprintf(out, ", \"steps_per_sec\": %.1f", r.ops / r.seconds);
+        }
+        std::fprintf(out, ", \"allocations_per_op\": %.4f }%s\n", static_cast<double>(r.allocations) / r.ops,
+                     (k + 1 < results.size()) ? "," : "");
+    }
+    std::fprintf(out, "  ]");
+}
+
+int main(int argc, char** argv) {
+    std::vector<Result> micro = { benchIntegrate(), benchCollision(), benchPocket(), benchFoul(), benchAim() };
+    std::vector<Result> scenarios = { scenarioBreak(), scenarioBreakStream(), scenarioBreakPrecision<double>(), scenarioBreakPrecision<Fixed32>(),
+                                      scenarioBreakTable<Table9ft>(), scenarioBreakProfile<Table9ft>(),
+                                      scenarioBreakTable<Snooker12ft>(), scenarioBreakProfile<Snooker12ft>(),
+                                      scenarioBreakEvents(), scenarioMidgame(true), scenarioMidgame(false), scenarioStress(), scenarioBatch() };
+
+    std::FILE* out = (argc > 1) ? std::fopen(argv[1], "w") : stdout;
+    if (!out) {
+        std::fprintf(stderr, "Tidak bisa menulis %s\n", argv[1]);
+        return 1;
+    }
+
+    std::fprintf(out, "{\n  \"integrator\": \"%s\",\n  \"step_rate\": %.0f,\n  \"substeps\": %d,\n",
+                 integratorName(detectIntegrator()), PhysicsStepRate, PhysicsSubsteps);
+    writeResults(out, "micro", micro, false);
+    std::fprintf(out, ",\n");
+    writeResults(out, "scenarios", scenarios, true);
+    std::fprintf(out, "\n}\n");
+
+    if (out != stdout) std::fclose(out);
+    return 0;
+}
@@ -0,0 +1,196 @@
+// Server headless: N meja independen dimainkan bot, disimulasikan di thread pool.
+// Untuk liga bot dan load test. Hasil ditulis sebagai JSON ke stdout.
+// Build: g++ -std=c++17 -O2 billiard_server.cpp -o billiard_server -pthread
+//
+// Opsi: --tables N (256)  --matches M (1000)  --threads T (jumlah core)
+//       --think MS (250, waktu bot memilih pukulan)  --tick STEPS (4, langkah fisika per tick)
+//       --table NAMA|FILE (classic; 7ft, 8ft, 9ft, atau file profil, lihat loadTableProfile)
+//
+// Waktu server berjalan dalam langkah fisika virtual secepat mungkin. Meja yang
+// diam keluar dari daftar aktif dan tidak disentuh sama sekali sampai pukulan
+// berikutnya tiba; bila semua meja diam, waktu langsung lompat ke pukulan terdekat.
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "TableState.cpp"
+#include "TableConfig.cpp"
+#include "TableSession.cpp"
+#include "WorkStealingPool.cpp"
+
+// Histogram latensi tick dalam mikrodetik (ember 0,1 us sampai 100 ms).
+class LatencyHistogram {
+private:
+    static const int BucketsPerMicro = 10;
+    static const int MaxMicros = 100000;
+    std::vector<std::uint64_t> buckets;
+    std::uint64_t count;
+    double maxMicros;
+
+public:
+    LatencyHistogram() : buckets(MaxMicros * BucketsPerMicro + 1, 0), count(0), maxMicros(0.0) {}
+
+    void add(double micros) {
+        int bucket = std::min(static_cast<int>(micros * BucketsPerMicro), MaxMicros * BucketsPerMicro);
+        ++buckets[bucket];
+        ++count;
+        maxMicros = std::max(maxMicros, micros);
+    }
+
+    double percentile(double p) const {
+        if (count == 0) return 0.0;
+        std::uint64_t rank = static_cast<std::uint64_t>(p * (count - 1));
+        std::uint64_t seen = 0;
+        for (std::size_t b = 0; b < buckets.size(); ++b) {
+            seen += buckets[b];
+            if (seen > rank) return static_cast<double>(b) / BucketsPerMicro;
+        }
+        return maxMicros;
+    }
+
+    double max() const {
+        return maxMicros;
+    }
+
+    std::uint64_t size() const {
+        return count;
+    }
+};
+
+struct Options {
+    int tables = 256;
+    int matches = 1000;
+    unsigned threads = std::thread::hardware_concurrency();
+    int thinkMillis = 250;
+    int tickSteps = 4;
+    std::string table = ClassicTable::name;
+};
+
+Options parseOptions(int argc, char** argv) {
+    Options options;
+    for (int k = 1; k + 1 < argc; k += 2) {
+        std::string key = argv[k];
+        int value = std::atoi(argv[k + 1]);
+        if (key == "--table") options.table = argv[k + 1];
+        else if (key == "--tables") options.tables = std::max(1, value);
+        else if (key == "--matches") options.matches = std::max(1, value);
+        else if (key == "--threads") options.threads = static_cast<unsigned>(std::max(1, value));
+        else if (key == "--think") options.thinkMillis = std::max(0, value);
+        else if (key == "--tick") options.tickSteps = std::max(1, value);
+        else std::fprintf(stderr, "Opsi tidak dikenal: %s\n", key.c_str());
+    }
+    return options;
+}
+
+int main(int argc, char** argv) {
+    typedef std::chrono::steady_clock Clock;
+    Options options = parseOptions(argc, argv);
+
+    TableProfile profile;
+    if (!selectTableProfile(options.table, profile)) {
+        std::fprintf(stderr, "Meja tidak dikenal: %s\n", options.table.c_str());
+        return 1;
+    }
+    if (!isEightBallProfile(profile)) {
+        std::fprintf(stderr, "Meja %s bukan meja 8-ball (16 bola, rak segitiga)\n", profile.name.c_str());
+        return 1;
+    }
+    const TableGeometry geometry(profile);
+
+    WorkStealingPool pool(options.threads);
+    TableState rack = makeRack(profile);
+    std::vector<std::unique_ptr<TableSession>> sessions;
+    for (int t = 0; t < options.tables; ++t) {
+        sessions.push_back(std::unique_ptr<TableSession>(new TableSession(rack, 1000u + t, profile, geometry)));
+    }
+
+    // Pukulan berikutnya per meja diam: (langkah virtual, meja), terdekat lebih dulu
+    typedef std::pair<std::uint64_t, int> Arrival;
+    std::priority_queue<Arrival, std::vector<Arrival>, std::greater<Arrival>> arrivals;
+    const std::uint64_t thinkSteps = static_cast<std::uint64_t>(options.thinkMillis * PhysicsStepRate / 1000.0f);
+    for (int t = 0; t < options.tables; ++t) {
+        arrivals.push(Arrival(thinkSteps, t));
+    }
+
+    std::vector<int> awake;
+    std::vector<double> tickMicros;
+    LatencyHistogram latency;
+    std::uint64_t now = 0;
+    std::uint64_t tableTicks = 0;
+    std::uint64_t restingTableTicks = 0; // tick yang dilewati karena meja diam
+    std::uint64_t shots = 0;
+    int finishedMatches = 0;
+    int wins[3] = { 0, 0, 0 };
+
+    // Tabel dibagi ke tugas berisi beberapa meja supaya overhead antrean kecil
+    const int TablesPerTask = 8;
+    auto start = Clock::now();
+
+    while (finishedMatches < options.matches) {
+        if (awake.empty() && !arrivals.empty()) {
+            now = std::max(now, arrivals.top().first);
+        }
+        while (!arrivals.empty() && arrivals.top().first <= now) {
+            TableSession& session = *sessions[arrivals.top().second];
+            session.shoot(session.chooseShot());
+            awake.push_back(arrivals.top().second);
+            arrivals.pop();
+            ++shots;
+        }
+
+        tickMicros.assign(awake.size(), 0.0);
+        for (std::size_t first = 0; first < awake.size(); first += TablesPerTask) {
+            std::size_t last = std::min(awake.size(), first + TablesPerTask);
+            pool.submit([&, first, last] {
+                for (std::size_t k = first; k < last; ++k) {
+                    auto tickStart = Clock::now();
+                    sessions[awake[k]]->tick(options.tickSteps);
+                    tickMicros[k] = std::chrono::duration<double, std::micro>(Clock::now() - tickStart).count();
+                }
+            });
+        }
+        pool.wait();
+
+        tableTicks += awake.size();
+        restingTableTicks += options.tables - awake.size();
+        now += options.tickSteps;
+
+        std::size_t kept = 0;
+        for (std::size_t k = 0; k < awake.size(); ++k) {
+            latency.add(tickMicros[k]);
+            TableSession& session = *sessions[awake[k]];
+            if (!session.isResting()) {
+                awake[kept++] = awake[k];
+                continue;
+            }
+            if (session.isFinished()) {
+                ++finishedMatches;
+                ++wins[session.getWinner()];
+                session.reset();
+            }
+            arrivals.push(Arrival(now + thinkSteps, awake[k]));
+        }
+        awake.resize(kept);
+    }
+
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    std::printf("{\n  \"table\": \"%s\",\n  \"tables\": %d,\n  \"threads\": %u,\n  \"tick_steps\": %d,\n  \"think_ms\": %d,\n",
+                profile.name.c_str(), options.tables, static_cast<unsigned>(pool.size()), options.tickSteps,
+                options.thinkMillis);
+    std::printf("  \"matches\": %d,\n  \"wins\": [%d, %d],\n  \"draws\": %d,\n  \"shots\": %llu,\n",
+                finishedMatches, wins[1], wins[2], wins[0], static_cast<unsigned long long>(shots));
+    std::printf("  \"wall_seconds\": %.3f,\n  \"simulated_seconds\": %.1f,\n  \"matches_per_sec\": %.2f,\n",
+                seconds, now / PhysicsStepRate, finishedMatches / seconds);
+    std::printf("  \"table_ticks\": %llu,\n  \"resting_table_ticks_skipped\": %llu,\n",
+                static_cast<unsigned long long>(tableTicks), static_cast<unsigned long long>(restingTableTicks));
+    std::printf("  \"tick_latency_us\": { \"p50\": %.1f, \"p99\": %.1f, \"max\": %.1f }\n}\n",
+                latency.percentile(0.5), latency.percentile(0.99), latency.max());
+    return 0;
+}
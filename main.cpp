@@ -2,120 +2,226 @@
 #include <iostream>
 #include <vector>
 #include <cmath>
+#include <future>
 #include "Ball.cpp"
+#include "Physics.cpp"
+#include "TableConfig.cpp"
+#include "FixedStepClock.cpp"
+#include "EventEngine.cpp"
+#include "PhysicsEvents.cpp"
+#include "ShotStats.cpp"
+#include "Rules.cpp"
+#include "MatchRules.cpp"
+#include "AiOpponent.cpp"
+#include "BallSlots.cpp"
+#include "BallRenderer.cpp"
+#include "TableLayer.cpp"
 #include "Stick.cpp"
 #include "PoolTable.cpp"
 #include "Player.cpp"
 #include "Score.cpp"
 #include "Alert.cpp"
 #include "StartMenu.cpp"
-
-bool isBallStopped(const sf::Vector2f& velocity) {
-    return std::abs(velocity.x) < MinVelocity && std::abs(velocity.y) < MinVelocity;
+#include "AssetCache.cpp"
+#include "Replay.cpp"
+#include "RewindBuffer.cpp"
+#include "FrameProfiler.cpp"
+#include "ProfilerOverlay.cpp"
+#include "NetPeer.cpp"
+
+void drawBackground(sf::RenderTarget& window) {
+    sf::RectangleShape background(sf::Vector2f(BackWidth, BackHeight));
+    background.setFillColor(sf::Color(75, 46, 25));
+    window.draw(background);
 }
 
-void checkCollision(Ball& ball1, Ball& ball2) {
-    sf::Vector2f direction = ball2.getPosition() - ball1.getPosition();
-    float distance = std::sqrt(direction.x * direction.x + direction.y * direction.y);
-
-    if (distance < 2 * BallRadius) {
-        direction /= distance;
-
-        sf::Vector2f relativeVelocity = ball2.getVelocity() - ball1.getVelocity();
-        float speed = relativeVelocity.x * direction.x + relativeVelocity.y * direction.y;
-
-        if (speed < 0) { 
-            float impulse = 2 * speed / (1 / BallRadius + 1 / BallRadius);
-            sf::Vector2f impulseVector = direction * impulse;
+void reportFoul(Foul foul) {
+    switch (foul) {
+    case FoulScratch:
+        std::cout << "Foul: Bola putih masuk ke lubang (Scratch)." << std::endl;
+        break;
+    case FoulNoContact:
+        std::cout << "Foul: Cue ball tidak menyentuh bola lain." << std::endl;
+        break;
+    case FoulWrongBall:
+        std::cout << "Foul: Tidak mengenai bola target terlebih dahulu." << std::endl;
+        break;
+    default:
+        break;
+    }
+}
 
-            ball1.setVelocity(ball1.getVelocity() + impulseVector / BallRadius);
-            ball2.setVelocity(ball2.getVelocity() - impulseVector / BallRadius);
+// Samakan slot bola aktif dengan flag pocketed setelah state meja diganti (rewind, snapshot).
+void syncSlots(BallSlots<Ball>& balls, const TableState& state) {
+    for (int i = 0; i < static_cast<int>(balls.size()); ++i) {
+        if (state.isPocketed(i)) {
+            balls.deactivate(i);
+        } else {
+            balls.activate(i);
         }
     }
 }
 
-void drawBackground(sf::RenderWindow& window) {
-    sf::RectangleShape background(sf::Vector2f(BackWidth, BackHeight));
-    background.setFillColor(sf::Color(75, 46, 25));
-    window.draw(background);
+// Susun ulang papan skor dari meja setelah snapshot host: bola grup yang sudah
+// masuk selalu dihitung untuk pemain pemilik grup itu (lihat MatchRules::pocket).
+void rebuildScores(BallSlots<Ball>& balls, const TableState& state, const MatchRules& rules,
+                   Score& player1Score, Score& player2Score) {
+    player1Score.clear();
+    player2Score.clear();
+    for (int i = 0; i < static_cast<int>(balls.size()); ++i) {
+        int group = ballGroup(i);
+        if (group == GroupNone || !state.isPocketed(i)) continue;
+        if (rules.getPlayerType(1) == group) player1Score.addScore(balls[i].getID(), balls[i].getColor());
+        else if (rules.getPlayerType(2) == group) player2Score.addScore(balls[i].getID(), balls[i].getColor());
+    }
 }
 
-bool checkFoul(const std::vector<Ball>& balls, int currentPlayer, int player1Type, int player2Type) { 
-    bool foul = false;
-    bool cueBallHit = false;
-    bool targetBallHit = false;
-    bool cueBallPocketed = false;  
+// Aturan dan kedua papan skor, disimpan bersama rewind supaya bola yang kembali ke
+// meja tidak tetap terhitung.
+struct MatchSnapshot {
+    MatchRules rules;
+    Score player1Score;
+    Score player2Score;
 
-    for (const auto& ball : balls) {
-        if (ball.getID() == 0 && ball.isPocketed()) { 
-            cueBallPocketed = true;
-            std::cout << "Foul: Bola putih masuk ke lubang (Scratch)." << std::endl;
-        }
-       
-        if (ball.getID() == 0 && ball.isMoving()) {
-            cueBallHit = true;
-        } else if ((currentPlayer == 1 && player1Type != -1 && ball.getID() == player1Type) || 
-                   (currentPlayer == 2 && player2Type != -1 && ball.getID() == player2Type)) {
-            if (ball.isMoving()) {
-                targetBallHit = true;
-            }
+    friend bool operator==(const MatchSnapshot& a, const MatchSnapshot& b) {
+        return a.rules == b.rules && a.player1Score.getScore() == b.player1Score.getScore() &&
+               a.player2Score.getScore() == b.player2Score.getScore();
+    }
+};
+
+// Mode dua pemain lewat UDP:  billiard --host 5000  /  billiard --join 127.0.0.1 5000
+struct NetOptions {
+    bool enabled = false;
+    bool host = false;
+    std::string address;
+    unsigned short port = 0;
+};
+
+NetOptions parseNetOptions(int argc, char** argv) {
+    NetOptions options;
+    std::vector<std::string> args(argv + 1, argv + argc);
+    for (std::size_t k = 0; k < args.size(); ++k) {
+        if (args[k] == "--host" && k + 1 < args.size()) {
+            options.enabled = options.host = true;
+            options.port = static_cast<unsigned short>(std::stoi(args[k + 1]));
+        } else if (args[k] == "--join" && k + 2 < args.size()) {
+            options.enabled = true;
+            options.address = args[k + 1];
+            options.port = static_cast<unsigned short>(std::stoi(args[k + 2]));
         }
     }
+    return options;
+}
 
-    if (cueBallPocketed) {
-        foul = true;
+// Meja:  billiard --table 9ft  /  billiard --table meja.txt  (lihat loadTableProfile).
+// Kedua peer mode jaringan harus memakai meja yang sama; bila berbeda koneksi ditolak.
+std::string parseTableOption(int argc, char** argv) {
+    for (int k = 1; k + 1 < argc; ++k) {
+        if (std::string(argv[k]) == "--table") return argv[k + 1];
     }
+    return ClassicTable::name;
+}
 
-    if (!cueBallHit) {
-        std::cout << "Foul: Cue ball tidak menyentuh bola lain." << std::endl;
-        foul = true;
-    } else if ((currentPlayer == 1 && player1Type != -1 && !targetBallHit) || 
-               (currentPlayer == 2 && player2Type != -1 && !targetBallHit)) {
-        std::cout << "Foul: Tidak mengenai bola target terlebih dahulu." << std::endl;
-        foul = true;
-    }
+int main(int argc, char** argv) {
+    NetOptions netOptions = parseNetOptions(argc, argv);
 
-    return foul;
-}
+    TableProfile profile;
+    if (!selectTableProfile(parseTableOption(argc, argv), profile)) {
+        std::cerr << "Meja tidak dikenal\n";
+        return -1;
+    }
+    // Window dan aturan mengikuti meja bawaan: meja harus 8-ball dan muat di layar
+    if (!isEightBallProfile(profile) || profile.right() + profile.border > WindowWidth ||
+        profile.bottom() + profile.border > WindowHeight) {
+        std::cerr << "Meja " << profile.name << " tidak bisa dimainkan (harus 8-ball dan paling besar "
+                  << TableWidth << "x" << TableHeight << ")\n";
+        return -1;
+    }
+    const TableGeometry geometry(profile);
 
-int main() {
     sf::RenderWindow window(sf::VideoMode(BackWidth, BackHeight), "Billiard Simulation");
-
-    sf::Font font;
-    if (!font.loadFromFile("D:/sfmll/font/Roboto-Black.ttf")) {
+    window.setFramerateLimit(FrameRateLimit);
+
+    // Aset menu diminta lebih dulu; tekstur meja didekode di latar selama StartMenu tampil.
+    // Root aset bisa diganti lewat BILLIARD_ASSET_ROOT.
+    AssetCache assets;
+    assets.preloadTexture("bg/menu-bg.jpg");
+    assets.preloadFont("font/Roboto-Black.ttf");
+    assets.preloadTexture("bg/border_texture.jpg");
+    assets.preloadTexture("bg/green_texture.jpg");
+
+    std::shared_ptr<sf::Font> fontAsset = assets.font("font/Roboto-Black.ttf");
+    if (!fontAsset) {
         std::cerr << "Error loading font\n";
         return -1;
     }
+    const sf::Font& font = *fontAsset;
 
-    StartMenu menu;
+    StartMenu menu(assets);
     menu.show(window, font);
     bool gameStarted = false;
     while (!gameStarted && window.isOpen()) {
         gameStarted = menu.handleInput(window);
     }
 
-    std::vector<Ball> balls;
-    balls.push_back(Ball(BallRadius, sf::Vector2f(200.0f, 330.0f), sf::Color::White, 0, font)); 
-
-    balls.push_back(Ball(BallRadius, sf::Vector2f(650.0f, 330.0f), sf::Color(255, 255, 0), 1, font));
-    balls.push_back(Ball(BallRadius, sf::Vector2f(685.0f, 310.0f), sf::Color(0, 0, 255), 2, font));
-    balls.push_back(Ball(BallRadius, sf::Vector2f(685.0f, 350.0f), sf::Color(255, 0, 0), 3, font));
-    balls.push_back(Ball(BallRadius, sf::Vector2f(720.0f, 290.0f), sf::Color(128, 0, 128), 4, font));
-    balls.push_back(Ball(BallRadius, sf::Vector2f(720.0f, 330.0f), sf::Color(255, 165, 0), 5, font));
-    balls.push_back(Ball(BallRadius, sf::Vector2f(720.0f, 370.0f), sf::Color(0, 255, 0), 6, font));
-    balls.push_back(Ball(BallRadius, sf::Vector2f(755.0f, 270.0f), sf::Color(128, 0, 0), 7, font));
-    balls.push_back(Ball(BallRadius, sf::Vector2f(755.0f, 310.0f), sf::Color(0, 0, 0), 8, font));
-
-    balls.push_back(Ball(BallRadius, sf::Vector2f(755.0f, 350.0f), sf::Color(255, 255, 0), 9, font)); 
-    balls.push_back(Ball(BallRadius, sf::Vector2f(755.0f, 390.0f), sf::Color(0, 0, 255), 10, font)); 
-    balls.push_back(Ball(BallRadius, sf::Vector2f(790.0f, 250.0f), sf::Color(255, 0, 0), 11, font)); 
-    balls.push_back(Ball(BallRadius, sf::Vector2f(790.0f, 290.0f), sf::Color(128, 0, 128), 12, font)); 
-    balls.push_back(Ball(BallRadius, sf::Vector2f(790.0f, 330.0f), sf::Color(255, 165, 0), 13, font)); 
-    balls.push_back(Ball(BallRadius, sf::Vector2f(790.0f, 370.0f), sf::Color(0, 255, 0), 14, font)); 
-    balls.push_back(Ball(BallRadius, sf::Vector2f(790.0f, 410.0f), sf::Color(128, 0, 0), 15, font)); 
-
-    PoolTable table;
-    Stick cue;
+    TableState state;
+    BallSlots<Ball> balls; // slot i = bola dengan indeks TableState i
+    // Posisi rak dari konfigurasi meja; warna 9-15 sama dengan 1-7 (bergaris)
+    const sf::Color ballColors[8] = {
+        sf::Color::White, sf::Color(255, 255, 0), sf::Color(0, 0, 255), sf::Color(255, 0, 0),
+        sf::Color(128, 0, 128), sf::Color(255, 165, 0), sf::Color(0, 255, 0), sf::Color(128, 0, 0)
+    };
+    std::vector<RackSpot> rack = rackSpots(profile);
+    for (int id = 0; id < static_cast<int>(rack.size()); ++id) {
+        sf::Color color = (id == 8) ? sf::Color(0, 0, 0) : ballColors[(id > 8) ? id - 8 : id];
+        balls.add(Ball(state, profile.ballRadius, sf::Vector2f(rack[id].x, rack[id].y), color, id, font));
+    }
+
+    BallRenderer ballRenderer(balls.all());
+    BasicFixedStepClock<float, TableProfile> physicsClock(state, profile, geometry);
+    EventEngine eventEngine(state, geometry, profile.ballRadius);
+    bool eventDriven = false; // tombol E: ganti ke mode simulasi berbasis event
+
+    // Event fisika dari kedua mode simulasi: bola masuk dan statistik pukulan
+    // dibaca dari sini, bukan dengan memeriksa seluruh meja setiap frame
+    PhysicsEventStream physicsEvents;
+    physicsClock.setEventStream(&physicsEvents);
+    eventEngine.setEventStream(&physicsEvents);
+    PhysicsEventStream::Reader pocketEvents = physicsEvents.reader();
+    ShotStats shotStats(physicsEvents);
+
+    AiOpponent ai(geometry, profile.ballRadius);
+    bool aiOpponent = false; // tombol A: pemain 2 dimainkan komputer
+    std::future<Shot> aiShot;
+
+    // Rekam pertandingan: rak awal, setiap pukulan, dan keyframe berkala
+    ReplayRecorder recorder;
+    if (!recorder.begin("replay.brpl", state, profile)) {
+        std::cerr << "Replay tidak bisa direkam\n";
+    }
+
+    // Tombol panah kiri: mundur satu detik (mode latihan / tinjau sengketa)
+    RewindBuffer rewind;
+    RewindTimeline<MatchSnapshot> matchHistory;
+    double gameTime = 0.0;
+
+    PoolTable table(assets, profile, geometry);
+    TableLayer tableLayer(sf::Vector2f(BackWidth, BackHeight));
+    Stick cue(geometry, profile.ballRadius);
+
+    // Lockstep: hanya input pukulan yang dikirim, kedua sisi mensimulasikan sendiri.
+    // Host adalah pemain 1, client pemain 2.
+    std::unique_ptr<LockstepSession> lockstep;
+    std::unique_ptr<NetPeer> netPeer;
+    if (netOptions.enabled) {
+        lockstep.reset(new LockstepSession(state, netOptions.host, profileChecksum(profile)));
+        netPeer.reset(new NetPeer(*lockstep));
+        bool opened = netOptions.host ? netPeer->host(netOptions.port)
+                                      : netPeer->join(sf::IpAddress(netOptions.address), netOptions.port);
+        if (!opened) {
+            return -1;
+        }
+    }
 
     sf::Clock clock;
     sf::Text player1Text("Player 1", font, 25);
@@ -130,151 +236,272 @@ int main() {
     Score player1Score(font, (BackWidth / 4) - 100, 50);
     Score player2Score(font, (BackWidth * 3 / 4) - 100, 50);
 
-    int player1Type = -1; 
-    int player2Type = -1; 
-
-    int currentPlayer = 2; 
-    bool ballPocketed = false;
+    MatchRules rules;
 
     Alert alert(font, sf::Vector2f(BackWidth, BackHeight)); 
 
+#if defined(BILLIARD_PROFILE)
+    ProfilerOverlay profilerOverlay(font); // tombol P: overlay, tombol T: rekam trace Chrome
+#endif
+
     while (window.isOpen()) {
+        // Meja diam, stick tidak ditarik, dan komputer tidak sedang berpikir: tidur sampai ada
+        // input atau window perlu digambar ulang. Selain itu jalan penuh dengan batas frame rate.
+        // Mode jaringan tidak pernah tidur karena paket lawan harus tetap dibaca.
+        bool idle = !lockstep && !state.anyMoving() && !cue.isDragging() && !aiShot.valid();
+
+        // Tidur di luar frame profiler supaya waktu menunggu input tidak terhitung sebagai frame
         sf::Event event;
-        while (window.pollEvent(event)) {
+        bool pending = false;
+        if (idle) {
+            pending = window.waitEvent(event);
+            clock.restart(); // waktu tidur bukan waktu simulasi
+        }
+
+        PROFILE_FRAME_BEGIN();
+        PROFILE_BEGIN(PhaseEvents);
+        if (!idle) {
+            pending = window.pollEvent(event);
+        }
+        for (; pending; pending = window.pollEvent(event)) {
             if (event.type == sf::Event::Closed)
                 window.close();
+            if (event.type == sf::Event::Resized)
+                tableLayer.invalidate();
+
+            int currentPlayer = rules.getCurrentPlayer();
+            bool humanTurn = !(aiOpponent && currentPlayer == 2) && balls.isActive(CueBallIndex);
+            if (lockstep) {
+                // Pukulan hanya saat giliran sendiri dan meja diam, supaya input cukup untuk lawan
+                humanTurn = lockstep->isConnected() && currentPlayer == lockstep->localPlayer() &&
+                            !state.anyMoving() && !lockstep->hasRemoteShot();
+            }
 
-            if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
-                cue.startMove(balls[0].getPosition());
+            if (humanTurn && event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left) {
+                cue.startMove(balls[CueBallIndex].getPosition());
             }
-            if (event.type == sf::Event::MouseButtonReleased && event.mouseButton.button == sf::Mouse::Left) {
-                cue.endMove(balls[0], sf::Vector2f(sf::Mouse::getPosition(window)));
+            if (humanTurn && event.type == sf::Event::MouseButtonReleased && event.mouseButton.button == sf::Mouse::Left) {
+                Shot shot;
+                if (cue.endMove(balls[CueBallIndex], sf::Vector2f(sf::Mouse::getPosition(window)), shot)) {
+                    recorder.recordShot(state, physicsClock.getStepCount(), shot,
+                                        eventDriven ? ReplayEventDriven : ReplayFixedStep);
+                    if (lockstep) {
+                        lockstep->shotTaken(shot, static_cast<std::uint32_t>(physicsClock.getStepCount()), currentPlayer);
+                    }
+                }
+                if (eventDriven) {
+                    eventEngine.reset();
+                }
+            }
+            // Mode event-driven, komputer, dan rewind hanya untuk permainan lokal. Mode
+            // hanya diganti saat meja diam supaya setiap pukulan di replay punya satu mode.
+            if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::E && !lockstep && !state.anyMoving()) {
+                eventDriven = !eventDriven;
+                if (eventDriven) {
+                    eventEngine.reset();
+                }
+                std::cout << "Mode fisika: " << (eventDriven ? "event-driven" : "fixed-step") << std::endl;
+            }
+            if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::A && !lockstep) {
+                aiOpponent = !aiOpponent;
+                std::cout << "Player 2 dimainkan " << (aiOpponent ? "komputer" : "manusia") << "." << std::endl;
+            }
+            if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::Left && !lockstep && !aiShot.valid() && !rewind.empty()) {
+                gameTime = std::max(rewind.oldestTime(), gameTime - 1.0);
+                rewind.restore(gameTime, state);
+                rewind.discardAfter(gameTime);
+
+                MatchSnapshot match{ rules, player1Score, player2Score };
+                if (matchHistory.restore(gameTime, match)) {
+                    rules = match.rules;
+                    player1Score = match.player1Score;
+                    player2Score = match.player2Score;
+                    if (rules.getWinner() == 0) {
+                        alert.hide();
+                    }
+                }
+                matchHistory.discardAfter(gameTime);
+                pocketEvents.skip();
+                recorder.requestKeyframe();
+
+                syncSlots(balls, state);
+                if (eventDriven) {
+                    eventEngine.reset();
+                }
+                std::cout << "Rewind ke detik " << gameTime << "." << std::endl;
+            }
+#if defined(BILLIARD_PROFILE)
+            if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::P) {
+                profilerOverlay.toggle();
+            }
+            if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::T) {
+                if (!frameProfiler().isTracing()) {
+                    frameProfiler().startTrace();
+                    std::cout << "Merekam trace profiler..." << std::endl;
+                } else if (frameProfiler().stopTrace("trace.json")) {
+                    std::cout << "Trace ditulis ke trace.json." << std::endl;
+                }
             }
+#endif
         }
+        PROFILE_END(PhaseEvents);
 
-        float deltaTime = clock.restart().asSeconds();
+        float frameTime = clock.restart().asSeconds();
+        gameTime += frameTime;
 
-        for (auto& ball : balls) {
-            ball.update(deltaTime);
+        if (eventDriven) {
+            PROFILE_SCOPE(PhaseCollision);
+            eventEngine.advance(frameTime);
+        } else {
+            physicsClock.advance(frameTime);
         }
-        for (size_t i = 0; i < balls.size(); ++i) {
-            for (size_t j = i + 1; j < balls.size(); ++j) {
-                checkCollision(balls[i], balls[j]);
+
+        PROFILE_BEGIN(PhasePockets);
+        pocketEvents.drain([&](const PhysicsEvent& physicsEvent) {
+            const int i = physicsEvent.a;
+            if (physicsEvent.type != EventPocketed || !balls.isActive(i)) return;
+
+            Ball& ball = balls[i];
+            if (rules.getWinner() != 0) {
+                // Permainan sudah selesai: bola hanya diangkat dari meja
+                balls.deactivate(i);
+                return;
             }
-        }
 
-        bool foulOccurred = false; 
-
-        for (auto it = balls.begin(); it != balls.end();) {
-            if (table.isPocketed(*it)) {
-                int ballID = it->getID();
-
-                if (ballID == 0) {  
-                    std::cout << "Foul: Bola putih masuk ke lubang." << std::endl;
-                    it->respawn();  
-                    ballPocketed = true;
-                    foulOccurred = true;  
-                    currentPlayer = (currentPlayer == 1) ? 2 : 1;  
-                    ++it;
-                } else if (ballID == 8) {  
-                    std::cout << "Bola hitam masuk ke lubang. Permainan selesai!" << std::endl;
-                    int winner = (currentPlayer == 1) ? 2 : 1;
-                    std::cout << "Pemenangnya adalah Player " << winner << "!" << std::endl;
-                    alert.show(winner);
-                    break;
-                } else {  
-                    int ballType = (ballID >= 1 && ballID <= 7) ? 1 : 2;
-
-                    if (currentPlayer == 1) {
-                        if (player1Type == -1) {
-                            player1Type = ballType;
-                            player2Type = (ballType == 1) ? 2 : 1;
-                            std::cout << "Player 1 memilih bola " << ((player1Type == 1) ? "solid" : "striped") << "." << std::endl;
-                        }
-
-                        if (player1Type == ballType) {
-                            player1Score.addScore(ballID, it->getColor());
-                        } else {
-                            std::cout << "Player 1 memasukkan bola lawan. Ganti giliran!" << std::endl;
-                            currentPlayer = 2;
-                            player2Score.addScore(ballID, it->getColor());
-                        }
-                    } else {
-                        if (player2Type == -1) {
-                            player2Type = ballType;
-                            player1Type = (ballType == 1) ? 2 : 1;
-                            std::cout << "Player 2 memilih bola " << ((player2Type == 1) ? "solid" : "striped") << "." << std::endl;
-                        }
-
-                        if (player2Type == ballType) {
-                            player2Score.addScore(ballID, it->getColor());
-                        } else {
-                            std::cout << "Player 2 memasukkan bola lawan. Ganti giliran!" << std::endl;
-                            currentPlayer = 1;
-                            player1Score.addScore(ballID, it->getColor());
-                        }
-                    }
-                    ballPocketed = true;
-                    it = balls.erase(it);
+            int ballID = ball.getID();
+            int shooter = rules.getCurrentPlayer();
+            PocketResult pocketed = rules.pocket(ballID);
+
+            if (pocketed.kind == PocketCue) {
+                std::cout << "Foul: Bola putih masuk ke lubang." << std::endl;
+                balls.deactivate(i);
+            } else if (pocketed.kind == PocketEight) {
+                std::cout << "Bola hitam masuk ke lubang. Permainan selesai!" << std::endl;
+                std::cout << "Pemenangnya adalah Player " << rules.getWinner() << "!" << std::endl;
+                alert.show(rules.getWinner());
+                balls.deactivate(i);
+            } else {  
+                if (pocketed.groupChosen) {
+                    std::cout << "Player " << shooter << " memilih bola " << ((rules.getPlayerType(shooter) == GroupSolid) ? "solid" : "striped") << "." << std::endl;
+                }
+                if (pocketed.kind == PocketOpponent) {
+                    std::cout << "Player " << shooter << " memasukkan bola lawan. Ganti giliran!" << std::endl;
                 }
-            } else {
-                ++it;
+                Score& scorer = (pocketed.scorer == 1) ? player1Score : player2Score;
+                scorer.addScore(ballID, ball.getColor());
+                balls.deactivate(i);
             }
+        });
+
+        // Bola putih yang masuk baru dikembalikan setelah semua bola diam, sama dengan
+        // replay yang memasangnya kembali sebelum pukulan berikutnya (placeCueBall).
+        if (!balls.isActive(CueBallIndex) && !state.anyMoving()) {
+            balls[CueBallIndex].respawn();
+            balls.activate(CueBallIndex);
+            if (eventDriven) {
+                eventEngine.reset();
+            }
+        }
+        PROFILE_END(PhasePockets);
+
+        PROFILE_BEGIN(PhaseRules);
+        shotStats.update();
+        TurnResult turn = rules.update(state);
+        if (turn != TurnPlaying) {
+            std::cout << "Pukulan: " << shotStats.getBallHits() << " tumbukan bola, " << shotStats.getCushionHits()
+                      << " pantulan cushion, " << shotStats.getPocketed() << " bola masuk, "
+                      << shotStats.getDuration() << " detik." << std::endl;
+            shotStats.reset();
+        }
+        switch (turn) {
+        case TurnContinue:
+            std::cout << "Bola masuk! Pemain tetap melanjutkan giliran." << std::endl;
+            break;
+        case TurnFoul:
+            reportFoul(rules.getLastFoul());
+            std::cout << "Foul terjadi. Ganti giliran ke pemain " << rules.getCurrentPlayer() << "." << std::endl;
+            break;
+        case TurnMiss:
+            std::cout << "Tidak ada bola masuk. Ganti giliran ke pemain " << rules.getCurrentPlayer() << "." << std::endl;
+            break;
+        default:
+            break;
         }
 
-        static bool turnEnded = false;
-        if (isBallStopped(balls[0].getVelocity()) && !turnEnded) {
-            if (ballPocketed) {
-                std::cout << "Bola masuk! Pemain tetap melanjutkan giliran." << std::endl;
-                ballPocketed = false;  
-            } else {
-                if (checkFoul(balls, currentPlayer, player1Type, player2Type)) {  
-                    std::cout << "Foul terjadi. Ganti giliran ke pemain " << ((currentPlayer == 1) ? 2 : 1) << "." << std::endl;
-                } else {
-                    std::cout << "Tidak ada bola masuk. Ganti giliran ke pemain " << ((currentPlayer == 1) ? 2 : 1) << "." << std::endl;
-                }
-                currentPlayer = (currentPlayer == 1) ? 2 : 1;  
+        // Giliran komputer: cari pukulan di thread lain supaya window tetap responsif
+        if (aiOpponent && rules.getCurrentPlayer() == 2 && rules.isTurnEnded() && !state.anyMoving() && !alert.isVisible() && !aiShot.valid()) {
+            TableState snapshot = state;
+            MatchRules turnRules = rules;
+            aiShot = std::async(std::launch::async, [&ai, snapshot, turnRules] {
+                return ai.chooseShot(snapshot, turnRules);
+            });
+        }
+        if (aiShot.valid() && aiShot.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+            Shot shot = aiShot.get();
+            balls[CueBallIndex].strike(shot);
+            recorder.recordShot(state, physicsClock.getStepCount(), shot, eventDriven ? ReplayEventDriven : ReplayFixedStep);
+            if (eventDriven) {
+                eventEngine.reset();
             }
-            turnEnded = true;  
+            std::cout << "Komputer memukul (" << ai.getLastRolloutCount() << " simulasi)." << std::endl;
         }
+        PROFILE_END(PhaseRules);
+
+        if (lockstep) {
+            Shot remoteShot;
+            int shooter;
+            if (lockstep->applyRemoteShot(remoteShot, shooter)) {
+                rules.setCurrentPlayer(shooter);
+                recorder.recordShot(state, physicsClock.getStepCount(), remoteShot);
+                std::cout << "Player " << shooter << " memukul." << std::endl;
+            }
 
-        if (!isBallStopped(balls[0].getVelocity())) {
-            turnEnded = false;
-        }
+            netPeer->pump(gameTime, rules);
+            if (lockstep->hasTableMismatch()) {
+                std::cerr << "Lawan memakai meja (--table) yang berbeda; koneksi ditolak." << std::endl;
+                window.close();
+            }
 
-        for (size_t i = 0; i < balls.size(); ) { 
-            if (table.isPocketed(balls[i])) {
-                if (i == 0) { 
-                    balls[i].respawn(); 
-                    ++i;
-                } else { 
-                    balls.erase(balls.begin() + i); 
-                }
-            } else {
-                ++i;
+            if (lockstep->takeCorrection(rules)) {
+                recorder.requestKeyframe();
+                syncSlots(balls, state);
+                rebuildScores(balls, state, rules, player1Score, player2Score);
+                std::cout << "Meja tidak sinkron; disamakan dengan snapshot host." << std::endl;
             }
         }
 
-        cue.update(balls[0].getPosition(), sf::Vector2f(sf::Mouse::getPosition(window)));
+        rewind.record(state, gameTime);
+        matchHistory.record(MatchSnapshot{ rules, player1Score, player2Score }, gameTime);
+        matchHistory.trimBefore(rewind.oldestTime());
+
+        cue.update(state, balls[CueBallIndex].getPosition(), sf::Vector2f(sf::Mouse::getPosition(window)));
 
-        player1Text.setFillColor((currentPlayer == 1) ? sf::Color::White : sf::Color(100, 100, 100));
-        player2Text.setFillColor((currentPlayer == 2) ? sf::Color::White : sf::Color(100, 100, 100));
+        player1Text.setFillColor((rules.getCurrentPlayer() == 1) ? sf::Color::White : sf::Color(100, 100, 100));
+        player2Text.setFillColor((rules.getCurrentPlayer() == 2) ? sf::Color::White : sf::Color(100, 100, 100));
 
+        PROFILE_BEGIN(PhaseDraw);
         window.clear();
-        drawBackground(window);
-        table.draw(window);
+        tableLayer.update(window.getSize(), [&table](sf::RenderTarget& target) {
+            drawBackground(target);
+            table.draw(target);
+        });
+        window.draw(tableLayer);
         window.draw(player1Text);
         window.draw(player2Text);
 
         player1Score.draw(window);
         player2Score.draw(window);
 
-        for (const auto& ball : balls) {
-            ball.draw(window, font);
-        }
+        ballRenderer.update(balls, eventDriven ? eventEngine.alpha() : physicsClock.alpha());
+        window.draw(ballRenderer);
 
         cue.draw(window);
 
+#if defined(BILLIARD_PROFILE)
+        profilerOverlay.update(frameProfiler());
+        window.draw(profilerOverlay);
+#endif
+
         if (alert.isVisible()) {
             alert.draw(window);
 
@@ -288,6 +515,8 @@ int main() {
         }
 
         window.display();
+        PROFILE_END(PhaseDraw);
+        PROFILE_FRAME_END();
     }
     return 0;
 }
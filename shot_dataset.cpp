@@ -0,0 +1,538 @@
+// Generator dataset hasil pukulan untuk melatih model kualitas pukulan offline.
+// Rak dan pukulan acak disimulasikan sampai diam di semua core, lalu input dan
+// hasilnya ditulis ke file biner kolumnar yang bisa langsung di-mmap.
+// Build: g++ -std=c++17 -O2 shot_dataset.cpp -o shot_dataset -pthread
+//
+// Opsi: --shots N (100000)  --threads T (jumlah core)  --seed S (1)
+//       --out FILE (shots.bsd)  --batch B (4096, baris per tugas)
+//       --layout rack|scatter|mixed (mixed: seperempat break, sisanya meja tengah permainan)
+//       --table NAMA|FILE (classic; meja 8-ball lain atau file profil, lihat loadTableProfile)
+//
+// Format file (little-endian, semua offset absolut dari awal file):
+//
+//   header   32 byte   "BSDS", u16 versi, u16 jumlah kolom, u64 jumlah baris,
+//                      u64 seed, u32 jumlah bola, u32 ukuran header + skema
+//   skema    k * 32    nama kolom (16 byte, diisi nol), u8 tipe, u8 ukuran elemen,
+//                      u16 elemen per baris, u32 cadangan, u64 offset data kolom
+//   data     setiap kolom berurutan untuk semua baris, awal kolom rata 64 byte
+//
+// Baris ke-r kolom c ada di offset(c) + r * ukuran elemen * elemen per baris,
+// jadi pembaca cukup mmap file dan menunjuk array bertipe ke setiap kolom.
+// Jumlah baris di header baru ditulis setelah batch terakhir; file yang
+// terpotong di tengah jalan terbaca sebagai nol baris.
+//
+// Setiap baris dibangkitkan dari (seed, nomor baris) saja, jadi isi file sama
+// berapa pun jumlah thread dan ukuran batch.
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Constants.hpp"
+#include "TableState.cpp"
+#include "TableConfig.cpp"
+#include "FixedStepClock.cpp"
+#include "PhysicsEvents.cpp"
+#include "Replay.cpp"
+#include "Rules.cpp"
+#include "Shot.cpp"
+#include "WorkStealingPool.cpp"
+
+namespace dataset {
+
+const char Magic[4] = { 'B', 'S', 'D', 'S' };
+const std::uint16_t Version = 1;
+const std::size_t HeaderSize = 32;
+const std::size_t ColumnEntrySize = 32;
+const std::size_t ColumnNameSize = 16;
+const std::uint64_t ColumnAlign = 64;
+const int Balls = ClassicTable::ballCount;
+
+// Batas langkah per pukulan (satu menit simulasi); pukulan yang belum diam dicatat di kolom steps.
+const std::uint32_t MaxSteps = static_cast<std::uint32_t>(PhysicsStepRate * 60);
+
+enum ColumnType : std::uint8_t {
+    TypeU8,
+    TypeI8,
+    TypeU16,
+    TypeU32,
+    TypeF32
+};
+
+inline std::uint8_t typeSize(ColumnType type) {
+    switch (type) {
+    case TypeU16: return 2;
+    case TypeU32:
+    case TypeF32: return 4;
+    default: return 1;
+    }
+}
+
+enum Layout : std::uint8_t {
+    LayoutRack,     // break dari rak standar dengan urutan bola acak
+    LayoutScatter   // sebagian bola sudah masuk, sisanya tersebar acak
+};
+
+// Kolom dalam urutan di file. Mask bola memakai bit ke-i untuk bola i.
+enum ColumnId {
+    ColLayout,          // u8   Layout
+    ColPlayerGroup,     // i8   grup pemain untuk findFoul: -1 meja terbuka, 1 solid, 2 belang
+    ColStartX,          // f32  posisi awal setiap bola
+    ColStartY,
+    ColStartPocketed,   // u16  bola yang sudah masuk sebelum pukulan
+    ColDragX,           // f32  tarikan stick (startPos - mouse) seperti Stick::endMove
+    ColDragY,
+    ColAngle,           // f32  hasil shotFromDrag
+    ColPower,
+    ColPocketed,        // u16  bola yang masuk pada pukulan ini
+    ColFirstContact,    // i8   bola pertama yang disentuh bola putih, -1 bila tidak ada
+    ColFoul,            // u8   Foul dari findFoul
+    ColFinalX,          // f32  posisi akhir; tidak berarti untuk bola yang masuk
+    ColFinalY,
+    ColSteps,           // u32  langkah fisika sampai diam, MaxSteps bila dihentikan
+    ColBallHits,        // u16  tumbukan bola dengan bola
+    ColCushionHits,     // u16  pantulan cushion dan rahang
+    ColumnCount
+};
+
+struct Column {
+    const char* name;
+    ColumnType type;
+    std::uint16_t width;
+    std::uint64_t offset;
+
+    std::size_t rowBytes() const {
+        return static_cast<std::size_t>(typeSize(type)) * width;
+    }
+};
+
+inline std::vector<Column> makeSchema() {
+    std::vector<Column> columns = {
+        { "layout", TypeU8, 1, 0 },
+        { "player_group", TypeI8, 1, 0 },
+        { "start_x", TypeF32, Balls, 0 },
+        { "start_y", TypeF32, Balls, 0 },
+        { "start_pocketed", TypeU16, 1, 0 },
+        { "drag_x", TypeF32, 1, 0 },
+        { "drag_y", TypeF32, 1, 0 },
+        { "angle", TypeF32, 1, 0 },
+        { "power", TypeF32, 1, 0 },
+        { "pocketed", TypeU16, 1, 0 },
+        { "first_contact", TypeI8, 1, 0 },
+        { "foul", TypeU8, 1, 0 },
+        { "final_x", TypeF32, Balls, 0 },
+        { "final_y", TypeF32, Balls, 0 },
+        { "steps", TypeU32, 1, 0 },
+        { "ball_hits", TypeU16, 1, 0 },
+        { "cushion_hits", TypeU16, 1, 0 }
+    };
+    static_assert(Balls <= 16, "mask bola disimpan sebagai u16");
+    return columns;
+}
+
+inline std::uint64_t alignUp(std::uint64_t value) {
+    return (value + ColumnAlign - 1) / ColumnAlign * ColumnAlign;
+}
+
+// Isi offset setiap kolom untuk rows baris; mengembalikan ukuran file.
+inline std::uint64_t layoutColumns(std::vector<Column>& columns, std::uint64_t rows) {
+    std::uint64_t offset = alignUp(HeaderSize + ColumnEntrySize * columns.size());
+    for (Column& column : columns) {
+        column.offset = offset;
+        offset = alignUp(offset + rows * column.rowBytes());
+    }
+    return offset;
+}
+
+inline std::vector<std::uint8_t> encodeHeader(const std::vector<Column>& columns, std::uint64_t rows,
+                                              std::uint64_t seed) {
+    std::vector<std::uint8_t> out;
+    for (char c : Magic) replay::putU8(out, static_cast<std::uint8_t>(c));
+    replay::putU16(out, Version);
+    replay::putU16(out, static_cast<std::uint16_t>(columns.size()));
+    replay::putU64(out, rows);
+    replay::putU64(out, seed);
+    replay::putU32(out, Balls);
+    replay::putU32(out, static_cast<std::uint32_t>(HeaderSize + ColumnEntrySize * columns.size()));
+
+    for (const Column& column : columns) {
+        char name[ColumnNameSize] = {};
+        std::strncpy(name, column.name, ColumnNameSize - 1);
+        for (char c : name) replay::putU8(out, static_cast<std::uint8_t>(c));
+        replay::putU8(out, column.type);
+        replay::putU8(out, typeSize(column.type));
+        replay::putU16(out, column.width);
+        replay::putU32(out, 0);
+        replay::putU64(out, column.offset);
+    }
+    return out;
+}
+
+// Potongan baris berurutan, satu buffer per kolom.
+struct Batch {
+    std::uint64_t firstRow = 0;
+    std::size_t rows = 0;
+    std::vector<std::uint8_t> data[ColumnCount];
+
+    void reset(std::uint64_t first, std::size_t count, const std::vector<Column>& columns) {
+        firstRow = first;
+        rows = count;
+        for (int c = 0; c < ColumnCount; ++c) {
+            data[c].clear();
+            data[c].reserve(count * columns[c].rowBytes());
+        }
+    }
+};
+
+// Satu pukulan: meja awal, tarikan stick, dan grup pemain.
+struct ShotInput {
+    Layout layout;
+    int playerGroup;
+    Shot shot;
+    float dragX, dragY;
+};
+
+class Generator {
+private:
+    const std::uint64_t seed;
+    const int layoutMode; // -1 campuran, selain itu Layout
+    const TableProfile table;
+    const TableGeometry geometry;
+    const std::vector<RackSpot> spots;
+
+    struct Worker {
+        TableState state;
+        PhysicsEventStream events;
+        PhysicsEventStream::Reader reader;
+        BasicFixedStepClock<float, TableProfile> clock;
+
+        Worker(const TableProfile& table, const TableGeometry& geometry)
+            : state(makeRack(table)), events(1024), reader(events.reader()), clock(state, table, geometry) {
+            clock.setEventStream(&events);
+        }
+    };
+
+    bool nearPocket(float x, float y) const {
+        const float reach = table.captureRadius + table.ballRadius * 2;
+        for (const auto& pocket : geometry.getPockets()) {
+            if ((x - pocket.cx) * (x - pocket.cx) + (y - pocket.cy) * (y - pocket.cy) < reach * reach) return true;
+        }
+        return false;
+    }
+
+    bool overlaps(const TableState& state, int count, float x, float y) const {
+        const float spacing = table.ballRadius * 2 + 1.0f;
+        for (int j = 0; j < count; ++j) {
+            if (state.isPocketed(j)) continue;
+            float dx = state.posX[j] - x;
+            float dy = state.posY[j] - y;
+            if (dx * dx + dy * dy < spacing * spacing) return true;
+        }
+        return false;
+    }
+
+    static void placeBall(TableState& state, int i, float x, float y) {
+        state.posX[i] = state.prevX[i] = x;
+        state.posY[i] = state.prevY[i] = y;
+        state.velX[i] = 0.0f;
+        state.velY[i] = 0.0f;
+        state.flags[i] = 0;
+    }
+
+    // Bola acak di dalam meja, tidak bertumpuk dan tidak di mulut lubang.
+    void scatterBall(TableState& state, int i, float minX, float maxX, std::mt19937_64& rng) const {
+        std::uniform_real_distribution<float> x(minX, maxX);
+        std::uniform_real_distribution<float> y(table.top() + table.ballRadius, table.bottom() - table.ballRadius);
+        float bx = 0.0f, by = 0.0f;
+        for (int attempt = 0; attempt < 1000; ++attempt) {
+            bx = x(rng);
+            by = y(rng);
+            if (!overlaps(state, i, bx, by) && !nearPocket(bx, by)) break;
+        }
+        placeBall(state, i, bx, by);
+    }
+
+    // Break: urutan bola di segitiga diacak (bola 8 tetap di tengah), posisi
+    // digeser sedikit, bola putih di sembarang tempat di belakang head string.
+    void makeRackLayout(TableState& state, std::mt19937_64& rng) const {
+        const int eightSpot = 5;
+        std::vector<int> order;
+        for (int i = 1; i < Balls; ++i) {
+            if (i != 8) order.push_back(i);
+        }
+        std::shuffle(order.begin(), order.end(), rng);
+        order.insert(order.begin() + (eightSpot - 1), 8);
+
+        std::uniform_real_distribution<float> jitter(-0.5f, 0.5f);
+        for (int spot = 1; spot < Balls; ++spot) {
+            placeBall(state, order[spot - 1], spots[spot].x + jitter(rng), spots[spot].y + jitter(rng));
+        }
+        scatterBall(state, CueBallIndex, table.left() + table.ballRadius, table.left() + table.width / 4, rng);
+    }
+
+    // Tengah permainan: tiap bola objek sudah masuk dengan peluang setengah
+    // (bola 8 jarang), sisanya dan bola putih tersebar acak.
+    void makeScatterLayout(TableState& state, std::mt19937_64& rng) const {
+        std::uniform_real_distribution<float> chance(0.0f, 1.0f);
+        for (int i = 0; i < Balls; ++i) {
+            state.flags[i] = BallPocketed;
+        }
+        for (int i = 0; i < Balls; ++i) {
+            bool gone = i != CueBallIndex && chance(rng) < (i == 8 ? 0.1f : 0.5f);
+            if (gone) continue;
+            scatterBall(state, i, table.left() + table.ballRadius, table.right() - table.ballRadius, rng);
+        }
+        for (int i = 0; i < Balls; ++i) {
+            if (!state.isPocketed(i)) continue;
+            state.posX[i] = state.prevX[i] = 0.0f;
+            state.posY[i] = state.prevY[i] = 0.0f;
+            state.velX[i] = 0.0f;
+            state.velY[i] = 0.0f;
+        }
+    }
+
+    // Grup pemain dan tarikan stick. Separuh pukulan membidik bola sah dengan
+    // noise, sisanya ke arah acak; panjang tarikan kadang melewati MaxCueForce
+    // sehingga batas di shotFromDrag ikut terwakili.
+    ShotInput makeShot(const TableState& state, Layout layout, std::mt19937_64& rng) const {
+        ShotInput input;
+        input.layout = layout;
+        input.playerGroup = -1;
+        if (layout == LayoutScatter && std::uniform_int_distribution<int>(0, 3)(rng) != 0) {
+            input.playerGroup = std::uniform_int_distribution<int>(GroupSolid, GroupStriped)(rng);
+        }
+
+        std::vector<int> targets;
+        for (int i = 1; i < Balls; ++i) {
+            if (state.isPocketed(i)) continue;
+            if (input.playerGroup == -1 ? i != 8 : ballGroup(i) == input.playerGroup) targets.push_back(i);
+        }
+        if (targets.empty() && !state.isPocketed(8)) targets.push_back(8);
+
+        float angle;
+        std::uniform_real_distribution<float> uniformAngle(-3.14159265f, 3.14159265f);
+        if (!targets.empty() && std::uniform_int_distribution<int>(0, 1)(rng) == 0) {
+            int target = targets[std::uniform_int_distribution<std::size_t>(0, targets.size() - 1)(rng)];
+            std::normal_distribution<float> noise(0.0f, 0.05f);
+            angle = std::atan2(state.posY[target] - state.posY[CueBallIndex],
+                               state.posX[target] - state.posX[CueBallIndex]) + noise(rng);
+        } else {
+            angle = uniformAngle(rng);
+        }
+
+        float length = std::uniform_real_distribution<float>(0.05f, 1.1f)(rng) * MaxCueForce;
+        input.dragX = std::cos(angle) * length;
+        input.dragY = std::sin(angle) * length;
+        input.shot = shotFromDrag(input.dragX, input.dragY);
+        return input;
+    }
+
+    static std::uint16_t pocketedMask(const TableState& state) {
+        std::uint16_t mask = 0;
+        for (int i = 0; i < Balls; ++i) {
+            if (state.isPocketed(i)) mask |= static_cast<std::uint16_t>(1u << i);
+        }
+        return mask;
+    }
+
+    static void putPositions(std::vector<std::uint8_t>& out, const std::vector<float>& values) {
+        for (int i = 0; i < Balls; ++i) {
+            replay::putF32(out, values[i]);
+        }
+    }
+
+    void simulateRow(Worker& worker, std::uint64_t row, Batch& batch) const {
+        std::seed_seq sequence{ static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32),
+                                static_cast<std::uint32_t>(row), static_cast<std::uint32_t>(row >> 32) };
+        std::mt19937_64 rng(sequence);
+
+        Layout layout = static_cast<Layout>(layoutMode);
+        if (layoutMode < 0) layout = std::uniform_int_distribution<int>(0, 3)(rng) == 0 ? LayoutRack : LayoutScatter;
+
+        TableState& state = worker.state;
+        if (layout == LayoutRack) makeRackLayout(state, rng);
+        else makeScatterLayout(state, rng);
+        state.firstContact = -1;
+        const ShotInput input = makeShot(state, layout, rng);
+        const std::uint16_t startPocketed = pocketedMask(state);
+
+        auto& data = batch.data;
+        replay::putU8(data[ColLayout], input.layout);
+        replay::putU8(data[ColPlayerGroup], static_cast<std::uint8_t>(static_cast<std::int8_t>(input.playerGroup)));
+        putPositions(data[ColStartX], state.posX);
+        putPositions(data[ColStartY], state.posY);
+        replay::putU16(data[ColStartPocketed], startPocketed);
+        replay::putF32(data[ColDragX], input.dragX);
+        replay::putF32(data[ColDragY], input.dragY);
+        replay::putF32(data[ColAngle], input.shot.angle);
+        replay::putF32(data[ColPower], input.shot.power);
+
+        // Jam dipakai ulang antar baris; pulau tidur memvalidasi ulang meja yang diganti.
+        worker.reader.skip();
+        applyShot(state, input.shot);
+        std::uint32_t steps = 0;
+        int ballHits = 0, cushionHits = 0;
+        auto count = [&](const PhysicsEvent& event) {
+            if (event.type == EventBallHit) ++ballHits;
+            else if (event.type == EventCushionHit) ++cushionHits;
+        };
+        while (state.anyMoving() && steps < MaxSteps) {
+            worker.clock.tick();
+            ++steps;
+            worker.reader.drain(count);
+        }
+
+        replay::putU16(data[ColPocketed], static_cast<std::uint16_t>(pocketedMask(state) & ~startPocketed));
+        replay::putU8(data[ColFirstContact], static_cast<std::uint8_t>(static_cast<std::int8_t>(state.firstContact)));
+        replay::putU8(data[ColFoul], static_cast<std::uint8_t>(findFoul(state, input.playerGroup)));
+        putPositions(data[ColFinalX], state.posX);
+        putPositions(data[ColFinalY], state.posY);
+        replay::putU32(data[ColSteps], steps);
+        replay::putU16(data[ColBallHits], static_cast<std::uint16_t>(std::min(ballHits, 0xFFFF)));
+        replay::putU16(data[ColCushionHits], static_cast<std::uint16_t>(std::min(cushionHits, 0xFFFF)));
+    }
+
+public:
+    // profile harus meja 8-ball dengan Balls bola.
+    Generator(std::uint64_t baseSeed, int layout, const TableProfile& profile)
+        : seed(baseSeed), layoutMode(layout), table(profile), geometry(profile), spots(rackSpots(profile)) {}
+
+    // Aman dipanggil bersamaan untuk batch berbeda.
+    void run(Batch& batch) const {
+        Worker worker(table, geometry);
+        for (std::size_t k = 0; k < batch.rows; ++k) {
+            simulateRow(worker, batch.firstRow + k, batch);
+        }
+    }
+};
+
+} // namespace dataset
+
+struct Options {
+    std::uint64_t shots = 100000;
+    unsigned threads = std::thread::hardware_concurrency();
+    std::uint64_t seed = 1;
+    std::string out = "shots.bsd";
+    int batch = 4096;
+    int layout = -1;
+    std::string table = ClassicTable::name;
+};
+
+Options parseOptions(int argc, char** argv) {
+    Options options;
+    for (int k = 1; k + 1 < argc; k += 2) {
+        std::string key = argv[k];
+        std::string value = argv[k + 1];
+        if (key == "--shots") options.shots = std::max(1ull, std::strtoull(value.c_str(), nullptr, 10));
+        else if (key == "--threads") options.threads = static_cast<unsigned>(std::max(1, std::atoi(value.c_str())));
+        else if (key == "--seed") options.seed = std::strtoull(value.c_str(), nullptr, 10);
+        else if (key == "--out") options.out = value;
+        else if (key == "--table") options.table = value;
+        else if (key == "--batch") options.batch = std::max(1, std::atoi(value.c_str()));
+        else if (key == "--layout") {
+            if (value == "rack") options.layout = dataset::LayoutRack;
+            else if (value == "scatter") options.layout = dataset::LayoutScatter;
+            else if (value == "mixed") options.layout = -1;
+            else std::fprintf(stderr, "Layout tidak dikenal: %s\n", value.c_str());
+        }
+        else std::fprintf(stderr, "Opsi tidak dikenal: %s\n", key.c_str());
+    }
+    return options;
+}
+
+int main(int argc, char** argv) {
+    typedef std::chrono::steady_clock Clock;
+    Options options = parseOptions(argc, argv);
+
+    TableProfile profile;
+    if (!selectTableProfile(options.table, profile)) {
+        std::fprintf(stderr, "Meja tidak dikenal: %s\n", options.table.c_str());
+        return 1;
+    }
+    if (!isEightBallProfile(profile)) {
+        std::fprintf(stderr, "Meja %s bukan meja 8-ball (16 bola, rak segitiga)\n", profile.name.c_str());
+        return 1;
+    }
+
+    std::vector<dataset::Column> columns = dataset::makeSchema();
+    const std::uint64_t fileSize = dataset::layoutColumns(columns, options.shots);
+
+    std::ofstream file(options.out, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        std::fprintf(stderr, "Tidak bisa menulis %s\n", options.out.c_str());
+        return 1;
+    }
+    std::vector<std::uint8_t> header = dataset::encodeHeader(columns, 0, options.seed);
+    file.write(reinterpret_cast<const char*>(header.data()), header.size());
+
+    WorkStealingPool pool(options.threads);
+    const dataset::Generator generator(options.seed, options.layout, profile);
+
+    // Dua gelombang batch bergantian: satu disimulasikan di pool sementara
+    // gelombang sebelumnya ditulis, jadi memori tetap 2 * window batch.
+    const std::size_t window = pool.size() * 2;
+    std::vector<dataset::Batch> waves[2];
+    waves[0].resize(window);
+    waves[1].resize(window);
+
+    auto writeWave = [&](std::vector<dataset::Batch>& wave) {
+        for (dataset::Batch& batch : wave) {
+            if (batch.rows == 0) continue;
+            for (int c = 0; c < dataset::ColumnCount; ++c) {
+                const dataset::Column& column = columns[c];
+                file.seekp(static_cast<std::streamoff>(column.offset + batch.firstRow * column.rowBytes()));
+                file.write(reinterpret_cast<const char*>(batch.data[c].data()), batch.data[c].size());
+            }
+            batch.rows = 0;
+        }
+    };
+
+    auto start = Clock::now();
+    std::uint64_t next = 0;
+    int current = 0;
+    while (next < options.shots) {
+        for (dataset::Batch& batch : waves[current]) {
+            std::size_t rows = static_cast<std::size_t>(std::min<std::uint64_t>(options.batch, options.shots - next));
+            if (rows == 0) break;
+            batch.reset(next, rows, columns);
+            next += rows;
+            pool.submit([&generator, &batch] { generator.run(batch); });
+        }
+        writeWave(waves[1 - current]);
+        pool.wait();
+        current = 1 - current;
+    }
+    writeWave(waves[1 - current]);
+
+    // Terbitkan jumlah baris, lalu rata-kan ukuran file dengan kolom terakhir
+    header = dataset::encodeHeader(columns, options.shots, options.seed);
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(header.data()), header.size());
+    file.close();
+    if (!file) {
+        std::fprintf(stderr, "Gagal menulis %s\n", options.out.c_str());
+        return 1;
+    }
+    std::filesystem::resize_file(options.out, fileSize);
+
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    std::printf("{\n");
+    std::printf("  \"out\": \"%s\",\n", options.out.c_str());
+    std::printf("  \"table\": \"%s\",\n", profile.name.c_str());
+    std::printf("  \"threads\": %zu,\n", pool.size());
+    std::printf("  \"shots\": %llu,\n", static_cast<unsigned long long>(options.shots));
+    std::printf("  \"bytes\": %llu,\n", static_cast<unsigned long long>(fileSize));
+    std::printf("  \"seconds\": %.3f,\n", seconds);
+    std::printf("  \"shots_per_minute\": %.0f\n", options.shots * 60.0 / seconds);
+    std::printf("}\n");
+    return 0;
+}